@@ -70,11 +70,29 @@ class CppCodeGenerator:
             """Generate header guard macro name."""
             return filename.upper().replace('.', '_').replace('/', '_') + '_'
         
+        def param_type(param: Dict[str, Any], module: Optional[Dict[str, Any]] = None) -> str:
+            """Declared C++ type of a function parameter.
+            
+            Containers, strings and the module's own structures are passed by
+            const reference so calls do not copy them; scalars, enums and views
+            (std::span, std::string_view) are passed by value.
+            """
+            type_name = param['type'].strip()
+            if param.get('is_pointer'):
+                return f"{'const ' if param.get('is_const') else ''}{type_name}&"
+            
+            structures = {to_pascal_case(s['name']) for s in (module or {}).get('structures', [])}
+            is_view = type_name.startswith(('std::span<', 'std::string_view'))
+            if not is_view and (type_name.startswith('std::') or '<' in type_name or type_name in structures):
+                return f"const {type_name}&"
+            return f"{'const ' if param.get('is_const') else ''}{type_name}"
+        
         self.jinja_env.filters['upper'] = to_upper_case
         self.jinja_env.filters['snake_case'] = to_snake_case
         self.jinja_env.filters['camel_case'] = to_camel_case
         self.jinja_env.filters['pascal_case'] = to_pascal_case
         self.jinja_env.filters['header_guard'] = header_guard
+        self.jinja_env.filters['param_type'] = param_type
     
     def load_schema(self, schema_name: str) -> Dict[str, Any]:
         """Load JSON schema for validation."""
@@ -166,6 +184,11 @@ class CppCodeGenerator:
         template_name = "cmake/CMakeLists.txt.j2"
         return self.render_template(template_name, {'config': config})
     
+    def generate_cmake_package_config(self, config: Dict[str, Any]) -> str:
+        """Generate the CMake package config template used by install(EXPORT)."""
+        template_name = "cmake/Config.cmake.in.j2"
+        return self.render_template(template_name, {'config': config})
+    
     def generate_makefile(self, config: Dict[str, Any]) -> str:
         """Generate Makefile."""
         template_name = "make/Makefile.j2"
@@ -229,6 +252,8 @@ class CppCodeGenerator:
         if 'cmake' in config.get('build_systems', ['cmake']):
             cmake_content = self.generate_cmake(config)
             self.write_file(cmake_content, lib_dir / "CMakeLists.txt")
+            package_config_content = self.generate_cmake_package_config(config)
+            self.write_file(package_config_content, lib_dir / "cmake" / f"{config['name']}Config.cmake.in")
         
         if 'make' in config.get('build_systems', []):
             makefile_content = self.generate_makefile(config)
@@ -17,10 +17,12 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <stdexcept>
 
 #include <optional>
+#include <span>
 #include <string_view>
 
 namespace dataproc {
@@ -88,15 +90,29 @@ enum class PatternType : int {
  */
 std::string to_string(PatternType value);
 
+/**
+ * @brief Running statistics kept per series by OnlineAnomalyDetector
+ */
+enum class AnomalyModel : uint8_t {
+    Welford = 0,  ///< Mean and variance of every point so far
+    Ewma = 1,  ///< Exponentially weighted mean and variance, following drift
+};
+
+/**
+ * @brief Convert AnomalyModel to string
+ * @param value Enum value
+ * @return std::string String representation
+ */
+std::string to_string(AnomalyModel value);
 
 /**
  * @brief Result of data analysis
  */
 struct AnalysisResult {
-    bool pattern_found;  ///< Whether a pattern was detected
-    double confidence;  ///< Confidence level (0.0 to 1.0)
-    PatternType pattern_type;  ///< Type of detected pattern
-    std::unordered_map<std::string, std::string> metadata;  ///< Additional pattern metadata
+    bool pattern_found{};  ///< Whether a pattern was detected
+    double confidence{};  ///< Confidence level (0.0 to 1.0)
+    PatternType pattern_type{};  ///< Type of detected pattern
+    std::unordered_map<std::string, std::string> metadata{};  ///< Additional pattern metadata
 
     /**
      * @brief Default constructor
@@ -139,11 +155,164 @@ struct AnalysisResult {
     bool operator!=(const AnalysisResult& other) const noexcept;
 };
 
+/**
+ * @brief Settings for an OnlineAnomalyDetector
+ */
+struct OnlineAnomalyConfig {
+    AnomalyModel model = AnomalyModel::Ewma;  ///< Statistics kept per series
+    double threshold = 3.0;  ///< Standard deviations from the mean that make a point anomalous (> 0)
+    double alpha = 0.05;  ///< Weight of each new point, in (0, 1] (Ewma only)
+    uint32_t warmup = 30;  ///< Points a series absorbs before any are flagged (at least 2)
+    bool absorb_anomalies = true;  ///< Whether flagged points update the statistics (lets a level shift become normal)
+};
+
+/**
+ * @brief Verdict on one point seen by an OnlineAnomalyDetector
+ */
+struct AnomalyVerdict {
+    double score = 0.0;  ///< |value - mean| / standard deviation, from the statistics before the point (infinite when a flat series moves)
+    bool anomaly = false;  ///< Whether the series was warmed up and score exceeded the threshold
+};
+
 
 /* ========================================================================== */
 /* Class Declarations                                                         */
 /* ========================================================================== */
 
+class Matrix;
+
+/**
+ * @brief Read-only view of a column-major matrix of doubles
+ * 
+ * Element (row, col) lives at data()[col * stride() + row], so each column
+ * is contiguous and consecutive columns are stride() apart. A stride larger
+ * than rows() lets a view address a block of a bigger matrix, or padded
+ * storage, without copying. The viewed memory must outlive the view.
+ * 
+ * For the Analyzer, columns are variables and rows are samples.
+ */
+class MatrixView {
+public:
+    MatrixView() noexcept = default;
+
+    /**
+     * @brief View @p cols columns of @p rows values, @p stride apart
+     * @throws AnalyzerInvalidArgumentException if @p stride < @p rows, or @p data is null for a non-empty shape
+     */
+    MatrixView(const double* data, size_t rows, size_t cols, size_t stride);
+
+    /**
+     * @brief View densely packed columns (stride == rows)
+     */
+    MatrixView(const double* data, size_t rows, size_t cols);
+
+    /**
+     * @brief View all of @p matrix
+     */
+    MatrixView(const Matrix& matrix) noexcept;
+
+    size_t rows() const noexcept { return rows_; }
+    size_t cols() const noexcept { return cols_; }
+    size_t stride() const noexcept { return stride_; }
+    const double* data() const noexcept { return data_; }
+    bool empty() const noexcept { return rows_ == 0 || cols_ == 0; }
+
+    double operator()(size_t row, size_t col) const noexcept { return data_[col * stride_ + row]; }
+
+    std::span<const double> column(size_t col) const noexcept { return {data_ + col * stride_, rows_}; }
+
+    /**
+     * @brief View of the @p rows x @p cols block starting at (@p first_row, @p first_col)
+     * @throws AnalyzerInvalidArgumentException if the block does not fit
+     */
+    MatrixView block(size_t first_row, size_t first_col, size_t rows, size_t cols) const;
+
+private:
+    const double* data_ = nullptr;
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t stride_ = 0;
+};
+
+/**
+ * @brief Column-major matrix of doubles in one aligned allocation
+ * 
+ * The stride is rows() rounded up to a whole number of ALIGNMENT-byte
+ * lines, so every column starts aligned and can be loaded with full-width
+ * vector instructions; padding rows are zero. One allocation holds the
+ * whole matrix, unlike a vector of row vectors.
+ * 
+ * Example usage:
+ * @code
+ * Matrix samples(sample_count, variable_count);
+ * for (size_t v = 0; v < variable_count; ++v) {
+ *     std::span<double> column = samples.column(v);
+ *     // fill column...
+ * }
+ * Matrix correlations = analyzer.compute_correlation_matrix(samples);
+ * @endcode
+ */
+class Matrix {
+public:
+    /** Byte alignment of every column */
+    static constexpr size_t ALIGNMENT = 64;
+
+    Matrix() noexcept = default;
+
+    /**
+     * @brief Zero-filled @p rows x @p cols matrix
+     */
+    Matrix(size_t rows, size_t cols);
+
+    /**
+     * @brief Matrix whose column j is @p columns[j]
+     * @throws AnalyzerInvalidArgumentException if the columns differ in length
+     */
+    static Matrix from_columns(const std::vector<std::vector<double>>& columns);
+
+    /**
+     * @brief Dense copy of @p view
+     */
+    explicit Matrix(MatrixView view);
+
+    ~Matrix();
+
+    Matrix(const Matrix& other);
+    Matrix& operator=(const Matrix& other);
+    Matrix(Matrix&& other) noexcept;
+    Matrix& operator=(Matrix&& other) noexcept;
+
+    size_t rows() const noexcept { return rows_; }
+    size_t cols() const noexcept { return cols_; }
+    size_t stride() const noexcept { return stride_; }
+    double* data() noexcept { return data_.get(); }
+    const double* data() const noexcept { return data_.get(); }
+    bool empty() const noexcept { return rows_ == 0 || cols_ == 0; }
+
+    double& operator()(size_t row, size_t col) noexcept { return data_[col * stride_ + row]; }
+    double operator()(size_t row, size_t col) const noexcept { return data_[col * stride_ + row]; }
+
+    std::span<double> column(size_t col) noexcept { return {data_.get() + col * stride_, rows_}; }
+    std::span<const double> column(size_t col) const noexcept { return {data_.get() + col * stride_, rows_}; }
+
+    MatrixView view() const noexcept { return MatrixView(*this); }
+
+    /**
+     * @brief Copy out as one vector per column
+     */
+    std::vector<std::vector<double>> to_columns() const;
+
+private:
+    struct AlignedDelete {
+        void operator()(double* p) const noexcept;
+    };
+
+    std::unique_ptr<double[], AlignedDelete> data_;
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t stride_ = 0;
+};
+
 /**
  * @brief Analyzer class
  * 
@@ -212,14 +381,24 @@ public:
      * @endcode
      */
 AnalysisResult analyze_time_series(
-const std::vector<double> data,const std::vector<uint64_t> timestamps,const std::vector<PatternType> pattern_types    ) const;
+const std::vector<double>& data,const std::vector<uint64_t>& timestamps,const std::vector<PatternType>& pattern_types    ) const;
 
     /**
      * @brief Detect anomalies in data stream
      * 
+     * Scores every point with a robust z-score, its distance from the
+     * median in units of the MAD scaled to match the standard deviation
+     * on normal data, so the outliers themselves do not hide each other.
+     * A point is anomalous when its score exceeds the two-sided normal
+     * quantile of @p sensitivity (0.95 -> 1.96, 0.999 -> 3.29; 0 flags
+     * every point off the median). The scan runs on AVX-512 or AVX2 when
+     * the CPU has them. Non-finite points are ignored; when every finite
+     * point is equal nothing is anomalous.
+     * 
      * @param data Input data stream
-     * @param sensitivity Anomaly detection sensitivity
-     * @return std::vector<size_t> Function result
+     * @param sensitivity Confidence in [0, 1) a point needs to be called anomalous
+     * @return std::vector<size_t> Indices of the anomalous points, in increasing order
+     * @throws AnalyzerInvalidArgumentException if @p sensitivity is outside [0, 1)
      * @throws AnalyzerException on error
      * 
      * Example usage:
@@ -229,13 +408,26 @@ const std::vector<double> data,const std::vector<uint64_t> timestamps,const std:
      * @endcode
      */
 std::vector<size_t> detect_anomalies(
-const std::vector<double> data,double sensitivity = 0.95    ) const;
+const std::vector<double>& data,double sensitivity = 0.95    ) const;
+
+    /**
+     * @brief detect_anomalies() over a borrowed range; indices are relative to @p data
+     */
+    std::vector<size_t> detect_anomalies(std::span<const double> data, double sensitivity = 0.95) const;
 
     /**
      * @brief Compute correlation matrix for multivariate data
      * 
+     * Pearson correlations. Each variable is standardized once, then the
+     * matrix is formed as a cache-blocked Z^T Z product over tiles of
+     * variables, computing only the upper triangle and spreading tiles
+     * over a worker pool started on first use (one thread per core). The
+     * inner kernel runs on AVX-512 or AVX2 when the CPU has them. Entries
+     * of variables that are constant or hold non-finite samples are NaN.
+     * 
      * @param data Multivariate data (each inner vector is a variable)
-     * @return std::vector<std::vector<double>> Function result
+     * @return std::vector<std::vector<double>> Symmetric matrix, result[i][j] = corr(data[i], data[j])
+     * @throws AnalyzerInvalidArgumentException if the variables differ in length
      * @throws AnalyzerException on error
      * 
      * Example usage:
@@ -245,7 +437,16 @@ const std::vector<double> data,double sensitivity = 0.95    ) const;
      * @endcode
      */
 std::vector<std::vector<double>> compute_correlation_matrix(
-const std::vector<std::vector<double>> data    ) const;
+const std::vector<std::vector<double>>& data    ) const;
+
+    /**
+     * @brief compute_correlation_matrix() over the columns of @p data
+     * 
+     * Columns are variables and rows are samples, so a strided block of a
+     * larger matrix correlates a subset of variables or samples without a
+     * copy. The result is a cols() x cols() Matrix.
+     */
+    Matrix compute_correlation_matrix(MatrixView data) const;
 
 
     /**
@@ -265,6 +466,97 @@ private:
     std::unique_ptr<Impl> pimpl_;  ///< Private implementation pointer
 };
 
+/**
+ * @brief Incremental anomaly detector over many independent series
+ * 
+ * Each series keeps a point count, a mean and a spread (Welford's running
+ * sum of squares, or an exponentially weighted variance), 24 bytes in all,
+ * in arrays indexed by series. A point is scored against the statistics
+ * from before it arrived, then absorbed, so nothing is ever re-read and
+ * each point costs O(1) whatever the history length. Series are numbered
+ * densely from 0; updating a series past series_count() adds it.
+ * 
+ * Non-finite values are treated as missing samples: they are neither
+ * flagged nor absorbed. The detector is not thread-safe; give each thread
+ * its own, or a disjoint range of series behind external locking.
+ * 
+ * Example usage:
+ * @code
+ * OnlineAnomalyDetector detector({.model = AnomalyModel::Ewma, .threshold = 4.0}, series_count);
+ * std::vector<size_t> flagged;
+ * for (;;) {
+ *     read_tick(values);  // one value per series
+ *     detector.update_all(values, flagged);
+ * }
+ * @endcode
+ */
+class OnlineAnomalyDetector {
+public:
+    /**
+     * @brief Create a detector with @p series_count series and no history
+     * @throws AnalyzerInvalidArgumentException if @p config is out of range
+     */
+    explicit OnlineAnomalyDetector(const OnlineAnomalyConfig& config = {}, size_t series_count = 0);
+
+    ~OnlineAnomalyDetector();
+
+    OnlineAnomalyDetector(const OnlineAnomalyDetector&) = delete;
+    OnlineAnomalyDetector& operator=(const OnlineAnomalyDetector&) = delete;
+    OnlineAnomalyDetector(OnlineAnomalyDetector&& other) noexcept;
+    OnlineAnomalyDetector& operator=(OnlineAnomalyDetector&& other) noexcept;
+
+    /**
+     * @brief Score and absorb one point of @p series
+     */
+    AnomalyVerdict update(size_t series, double value);
+
+    /**
+     * @brief Score and absorb consecutive points of @p series
+     * 
+     * @param anomalies Receives the positions in @p values of flagged points (appended to)
+     * @return size_t Number of points flagged
+     */
+    size_t update(size_t series, std::span<const double> values, std::vector<size_t>& anomalies);
+
+    /**
+     * @brief Score and absorb one tick: @p values[i] is the next point of series i
+     * 
+     * Series beyond @p values.size() are left untouched.
+     * 
+     * @param anomalies Receives the series that were flagged (appended to)
+     * @return size_t Number of series flagged
+     */
+    size_t update_all(std::span<const double> values, std::vector<size_t>& anomalies);
+
+    size_t series_count() const noexcept;
+
+    /**
+     * @brief Points absorbed by @p series (0 for series not seen yet)
+     */
+    uint64_t count(size_t series) const noexcept;
+
+    /**
+     * @brief Current mean of @p series
+     */
+    double mean(size_t series) const noexcept;
+
+    /**
+     * @brief Current standard deviation of @p series
+     */
+    double stddev(size_t series) const noexcept;
+
+    /**
+     * @brief Forget the history of @p series
+     */
+    void reset(size_t series) noexcept;
+
+    const OnlineAnomalyConfig& config() const noexcept;
+
+private:
+    struct Impl;  ///< Forward declaration for PIMPL idiom
+    std::unique_ptr<Impl> pimpl_;  ///< Private implementation pointer
+};
+
 /* ========================================================================== */
 /* Free Function Declarations                                                */
 /* ========================================================================== */
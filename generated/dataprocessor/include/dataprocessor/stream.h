@@ -13,9 +13,13 @@
 #ifndef STREAM_
 #define STREAM_
 
+#include <coroutine>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 #include <stdexcept>
@@ -45,6 +49,36 @@ constexpr size_t DEFAULT_BUFFER_SIZE = 8192;
  */
 constexpr size_t MAX_PARALLEL_STREAMS = 16;
 
+/**
+ * @brief Default size of each StreamFileWriter buffer (one write request)
+ */
+constexpr size_t DEFAULT_WRITE_BUFFER_SIZE = 1024 * 1024;
+
+/**
+ * @brief Default number of StreamFileWriter writes kept in flight
+ */
+constexpr size_t DEFAULT_WRITE_QUEUE_DEPTH = 4;
+
+/**
+ * @brief Maximum number of StreamFileWriter writes kept in flight
+ */
+constexpr size_t MAX_WRITE_QUEUE_DEPTH = 64;
+
+/**
+ * @brief Default StreamProcessor high watermark when max_memory is unset
+ */
+constexpr size_t DEFAULT_HIGH_WATERMARK = 16 * 1024 * 1024;
+
+/**
+ * @brief Default bytes of input per StreamPipeline chunk
+ */
+constexpr size_t DEFAULT_PIPELINE_CHUNK_SIZE = 1024 * 1024;
+
+/**
+ * @brief Default number of chunks queued between StreamPipeline stages
+ */
+constexpr size_t DEFAULT_PIPELINE_QUEUE_DEPTH = 4;
+
 
 /* ========================================================================== */
 /* Exception Classes                                                          */
@@ -98,6 +132,21 @@ enum class StreamState : uint8_t {
  */
 std::string to_string(StreamState value);
 
+/**
+ * @brief Whether a StreamProcessor wants more input
+ */
+enum class FlowState : uint8_t {
+    Open = 0,  ///< Below the high watermark; keep pushing
+    Paused = 1,  ///< High watermark reached; stop reading until Open again
+};
+
+/**
+ * @brief Convert FlowState to string
+ * @param value Enum value
+ * @return std::string String representation
+ */
+std::string to_string(FlowState value);
+
 /**
  * @brief Data compression algorithms
  */
@@ -115,16 +164,70 @@ enum class CompressionType : int {
  */
 std::string to_string(CompressionType value);
 
+/**
+ * @brief Where a stream cuts its input into blocks
+ */
+enum class ChunkingMode : uint8_t {
+    Fixed = 0,  ///< Every buffer_size bytes
+    ContentDefined = 1,  ///< Where a rolling hash of the data matches (FastCDC), at most buffer_size bytes apart
+};
+
+/**
+ * @brief Convert ChunkingMode to string
+ * @param value Enum value
+ * @return std::string String representation
+ */
+std::string to_string(ChunkingMode value);
+
+/**
+ * @brief Receiver of processed data, called once per piece in order
+ * 
+ * The span is only valid for the duration of the call.
+ */
+using StreamSink = std::function<void(std::span<const uint8_t>)>;
+
+/**
+ * @brief One transform in a StreamPipeline
+ * 
+ * Called once per chunk, in order, on the stage's own thread. Appends the
+ * chunk's result to @p output, which arrives empty; leaving it empty drops
+ * the chunk.
+ */
+using StreamStage = std::function<void(std::span<const uint8_t> input, std::vector<uint8_t>& output)>;
+
+/**
+ * @brief Watermarks for a StreamProcessor's queued output
+ * 
+ * Buffered bytes are the pending partial chunk plus processed output not yet
+ * drained. The processor turns Paused when they reach high_watermark (or the
+ * queue reaches max_queue_depth entries) and Open again once they fall to
+ * low_watermark (and the queue to half of max_queue_depth). The gap between
+ * the two keeps a reader from flapping on every message.
+ * 
+ * on_change normally runs on the thread that caused the transition. Calls
+ * never overlap: a transition raised while a callback is running, even by
+ * that callback, is delivered by the thread running it once it returns.
+ */
+struct StreamFlowControl {
+    size_t high_watermark = 0;  ///< Bytes that pause input (0 = half of StreamConfig::max_memory, or DEFAULT_HIGH_WATERMARK when that is 0)
+    size_t low_watermark = 0;  ///< Bytes that resume input (0 = half of high_watermark)
+    size_t max_queue_depth = 0;  ///< Queued output entries that also pause input (0 = no limit)
+    std::function<void(FlowState)> on_change;  ///< Called on every transition, in order and without the processor's lock, so it may call back into the processor
+};
 
 /**
  * @brief Configuration for stream processing
  */
 struct StreamConfig {
-    size_t buffer_size;  ///< Buffer size for stream operations
-    size_t max_memory;  ///< Maximum memory usage
-    uint32_t parallel_workers;  ///< Number of parallel workers
-    CompressionType compression;  ///< Compression algorithm to use
-    bool enable_checksum;  ///< Enable data integrity checksums
+    size_t buffer_size = DEFAULT_BUFFER_SIZE;  ///< Buffer size for stream operations (0 selects DEFAULT_BUFFER_SIZE)
+    size_t max_memory = 0;  ///< Maximum memory for working buffers, shared by every buffer pool and a StreamProcessor's queue (0 = no limit; must hold one encoded block per pool)
+    uint32_t parallel_workers = 1;  ///< Number of parallel workers (capped at MAX_PARALLEL_STREAMS)
+    CompressionType compression = CompressionType::None;  ///< Compression algorithm to use
+    bool enable_checksum = false;  ///< Enable data integrity checksums
+    int compression_level = 0;  ///< Codec-specific compression level (0 selects the codec default; Zstd only)
+    std::vector<uint8_t> dictionary;  ///< Optional trained dictionary, must match on decode (Zstd only)
+    ChunkingMode chunking = ChunkingMode::Fixed;  ///< Block boundaries (ContentDefined implies block framing and buffer_size >= 256)
+    size_t dedup_cache_entries = 0;  ///< Recent blocks indexed for back-references within a call (0 = off; implies block framing)
 
     /**
      * @brief Default constructor
@@ -171,10 +274,13 @@ struct StreamConfig {
  * @brief Stream processing statistics
  */
 struct StreamStats {
-    uint64_t bytes_processed;  ///< Total bytes processed
-    uint64_t processing_time_ms;  ///< Processing time in milliseconds
-    double throughput_mbps;  ///< Throughput in MB/s
-    uint32_t error_count;  ///< Number of errors encountered
+    uint64_t bytes_processed = 0;  ///< Total bytes processed
+    uint64_t processing_time_ms = 0;  ///< Processing time in milliseconds
+    double throughput_mbps = 0.0;  ///< Throughput in MB/s
+    uint32_t error_count = 0;  ///< Number of errors encountered
+    uint64_t compressed_bytes = 0;  ///< Encoded bytes produced, block headers included
+    double compression_ratio = 0.0;  ///< Uncompressed / compressed bytes (0 when nothing was encoded)
+    double codec_time_ms = 0.0;  ///< Time spent inside the compression codecs, summed over workers
 
     /**
      * @brief Default constructor
@@ -222,6 +328,490 @@ struct StreamStats {
 /* Class Declarations                                                         */
 /* ========================================================================== */
 
+/**
+ * @brief Processed data handed back as spans instead of a copied vector
+ * 
+ * Filled by Stream::process_data() without copying into a caller-owned
+ * vector. Each segment is either a buffer owned by the stream's segment pool
+ * (framed streams encode straight into it) or, for pass-through streams, a
+ * view of the input itself, which must then outlive the segments. The spans
+ * map one-to-one onto iovec entries for writev()/sendmsg().
+ * 
+ * Pool buffers are returned by release() or on destruction, and the pool
+ * keeps them for reuse. The pool is created on the first segmented call.
+ * Within a StreamConfig::max_memory budget it never grows: a call that
+ * needs more buffers than are free throws instead of allocating, so held
+ * segments push back on the producer rather than on memory. Without a
+ * budget the pool grows to what is held at once.
+ * 
+ * Example usage:
+ * @code
+ * StreamSegments segments;
+ * instance.process_data(input, segments);
+ * std::vector<iovec> iov;
+ * for (auto segment : segments.segments()) {
+ *     iov.push_back({const_cast<uint8_t*>(segment.data()), segment.size()});
+ * }
+ * writev(fd, iov.data(), static_cast<int>(iov.size()));
+ * segments.release();
+ * @endcode
+ */
+class StreamSegments {
+public:
+    StreamSegments();
+    ~StreamSegments();
+
+    StreamSegments(const StreamSegments&) = delete;
+    StreamSegments& operator=(const StreamSegments&) = delete;
+
+    StreamSegments(StreamSegments&& other) noexcept;
+    StreamSegments& operator=(StreamSegments&& other) noexcept;
+
+    /**
+     * @brief The processed data, in order
+     */
+    std::span<const std::span<const uint8_t>> segments() const noexcept { return segments_; }
+
+    /**
+     * @brief Total bytes over all segments
+     */
+    size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Whether there are no segments
+     */
+    bool empty() const noexcept { return segments_.empty(); }
+
+    /**
+     * @brief Drop every segment and return its buffer
+     */
+    void release() noexcept;
+
+private:
+    friend class Stream;
+
+    struct Storage;  ///< Ownership of the buffers behind segments_
+    std::vector<std::span<const uint8_t>> segments_;
+    size_t size_ = 0;
+    std::unique_ptr<Storage> storage_;
+};
+
+/**
+ * @brief Writes processed data to a file descriptor in the background
+ * 
+ * Data passed to write() is copied into one of queue_depth buffers, and
+ * each full buffer is written while the caller carries on, so encoding the
+ * next blocks overlaps the I/O of the previous ones. On Linux the writes go
+ * through io_uring with the buffers registered once up front; where
+ * io_uring is unavailable (old kernel, seccomp, io_uring_disabled) helper
+ * threads issue pwrite() instead. Either way the bytes land at consecutive
+ * offsets from the descriptor's position when the writer was created.
+ * 
+ * The descriptor must be seekable and not opened with O_APPEND; it stays
+ * owned by the caller. A writer is driven by one thread at a time.
+ * 
+ * Example usage:
+ * @code
+ * StreamFileWriter writer(fd);
+ * instance.process_file("input.bin", writer.sink());
+ * writer.flush();
+ * @endcode
+ */
+class StreamFileWriter {
+public:
+    /**
+     * @brief Start writing at the current position of @p fd
+     * @param fd Descriptor to write to
+     * @param buffer_size Bytes per write request (0 selects DEFAULT_WRITE_BUFFER_SIZE)
+     * @param queue_depth Writes in flight (0 selects DEFAULT_WRITE_QUEUE_DEPTH, capped at MAX_WRITE_QUEUE_DEPTH)
+     * @param use_io_uring Whether io_uring may be used when the system supports it
+     * @throws StreamInvalidArgumentException if @p buffer_size exceeds 1 GiB
+     * @throws StreamRuntimeException if @p fd cannot be written at an offset
+     */
+    explicit StreamFileWriter(int fd, size_t buffer_size = DEFAULT_WRITE_BUFFER_SIZE,
+                              size_t queue_depth = DEFAULT_WRITE_QUEUE_DEPTH, bool use_io_uring = true);
+
+    /**
+     * @brief Write anything still queued and wait for it
+     * 
+     * Errors at this point are lost; call flush() first to see them.
+     */
+    ~StreamFileWriter();
+
+    StreamFileWriter(const StreamFileWriter&) = delete;
+    StreamFileWriter& operator=(const StreamFileWriter&) = delete;
+
+    StreamFileWriter(StreamFileWriter&& other) noexcept;
+    StreamFileWriter& operator=(StreamFileWriter&& other) noexcept;
+
+    /**
+     * @brief Queue @p data for writing
+     * 
+     * Returns as soon as the data is copied; blocks only while every buffer
+     * is being written.
+     * 
+     * @throws StreamRuntimeException if an earlier write failed
+     */
+    void write(std::span<const uint8_t> data);
+
+    /**
+     * @brief Write everything queued and wait for the writes to complete
+     * 
+     * Afterwards the descriptor's position is just past the written data.
+     * 
+     * @throws StreamRuntimeException if any write failed
+     */
+    void flush();
+
+    /**
+     * @brief A sink that forwards to write(), for Stream::process_data() and process_file()
+     * 
+     * The sink refers to this writer and must not outlive it.
+     */
+    StreamSink sink();
+
+    /**
+     * @brief Bytes queued by write() since construction
+     */
+    uint64_t bytes_written() const noexcept;
+
+    /**
+     * @brief Whether writes go through io_uring rather than pwrite() threads
+     */
+    bool uses_io_uring() const noexcept;
+
+private:
+    struct Impl;  ///< Forward declaration for PIMPL idiom
+    std::unique_ptr<Impl> pimpl_;  ///< Private implementation pointer
+};
+
+class StreamExecutor;
+class StreamProcessor;
+
+/**
+ * @brief Awaitable returned by StreamProcessor::async_push() and async_flush()
+ * 
+ * The operation itself runs as soon as it is awaited, on the awaiting
+ * thread. The coroutine is then suspended only while the processor asks
+ * the producer to wait (FlowState::Paused for a push, queued output for a
+ * flush), without holding a thread, and is resumed on the executor when a
+ * drain() lets it continue. Errors are rethrown from the co_await.
+ */
+class StreamOperation {
+public:
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle);
+    void await_resume();
+
+private:
+    friend class StreamProcessor;
+
+    enum class Kind : uint8_t {
+        Push,  ///< Resumes once the flow state is Open
+        Flush,  ///< Resumes once the output queue is empty
+    };
+
+    StreamOperation(StreamProcessor& processor, StreamExecutor& executor, Kind kind,
+                    std::span<const uint8_t> input) noexcept
+        : processor_(&processor), executor_(&executor), kind_(kind), input_(input)
+    {
+    }
+
+    StreamProcessor* processor_;
+    StreamExecutor* executor_;
+    Kind kind_;
+    std::span<const uint8_t> input_;
+    std::coroutine_handle<> continuation_;
+    std::exception_ptr error_;
+};
+
+/**
+ * @brief Stateful processor for input that arrives incrementally
+ * 
+ * Owns the same machinery as a Stream (worker pool, codec contexts, working
+ * buffers), built once and reused for every call. Input is cut into
+ * StreamConfig::buffer_size chunks across push() calls: whole chunks are
+ * processed as soon as they are complete and the remainder is held until
+ * more input arrives or the processor is flushed. Small messages therefore
+ * cost a copy into the pending chunk until it fills.
+ * 
+ * Output either goes straight to the caller's vector or, with the
+ * single-argument push(), into an internal queue that a consumer empties
+ * with drain(). Queued output is measured against the StreamFlowControl
+ * watermarks, so a network reader can pause on FlowState::Paused rather
+ * than let memory grow without bound when the consumer falls behind.
+ * 
+ * A coroutine producer can co_await async_push() instead, which suspends
+ * while the flow is Paused rather than blocking a thread, so a
+ * StreamExecutor with a few threads can serve thousands of processors.
+ * 
+ * A processor is driven by one producer at a time; drain() may run on a
+ * separate consumer thread, and get_statistics(), state(), flow_state(),
+ * buffered_bytes() and pending_bytes() may be called from any thread.
+ * 
+ * Example usage:
+ * @code
+ * StreamProcessor processor(config);
+ * for (const auto& message : messages) {
+ *     processor.push(message, output);
+ * }
+ * processor.finish(output);
+ * @endcode
+ * 
+ * With flow control:
+ * @code
+ * processor.set_flow_control({.high_watermark = 8 << 20, .on_change = [&](FlowState s) {
+ *     s == FlowState::Paused ? socket.pause_reading() : socket.resume_reading();
+ * }});
+ * socket.on_data([&](std::span<const uint8_t> data) { processor.push(data); });
+ * // consumer thread
+ * processor.drain(writer.sink());
+ * @endcode
+ */
+class StreamProcessor {
+public:
+    /**
+     * @brief Create a processor with its own workers and codec state
+     * @param config Stream configuration
+     * @throws StreamInvalidArgumentException if the configuration is invalid
+     * @throws StreamException on initialization failure
+     */
+    explicit StreamProcessor(const StreamConfig& config);
+
+    /**
+     * @brief Destructor
+     */
+    ~StreamProcessor();
+
+    StreamProcessor(const StreamProcessor&) = delete;
+    StreamProcessor& operator=(const StreamProcessor&) = delete;
+
+    /**
+     * @brief Move constructor
+     */
+    StreamProcessor(StreamProcessor&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator
+     */
+    StreamProcessor& operator=(StreamProcessor&& other) noexcept;
+
+    /**
+     * @brief Feed more input
+     * 
+     * Every chunk completed by @p input is processed and appended to
+     * @p output; a trailing partial chunk is kept for the next call.
+     * 
+     * @param input Next piece of input
+     * @param output Processed data (appended to)
+     * @throws StreamRuntimeException if the processor has finished or failed
+     */
+    void push(std::span<const uint8_t> input, std::vector<uint8_t>& output);
+
+    /**
+     * @brief Process the pending partial chunk now
+     * 
+     * With block framing this emits a short block, so flushing after every
+     * small message trades compression ratio for latency.
+     * 
+     * @param output Processed data (appended to)
+     * @throws StreamRuntimeException if the processor has finished or failed
+     */
+    void flush(std::vector<uint8_t>& output);
+
+    /**
+     * @brief Flush and mark the input as complete
+     * 
+     * Further push() and flush() calls throw until reset().
+     * 
+     * @param output Processed data (appended to)
+     * @throws StreamRuntimeException if the processor has finished or failed
+     */
+    void finish(std::vector<uint8_t>& output);
+
+    /**
+     * @brief Feed more input, queueing the output for drain()
+     * 
+     * Same chunking as push(input, output). The call never blocks on the
+     * consumer: it is up to the producer to stop reading while flow_state()
+     * is Paused.
+     * 
+     * @param input Next piece of input
+     * @throws StreamRuntimeException if the processor has finished or failed
+     */
+    void push(std::span<const uint8_t> input);
+
+    /**
+     * @brief Process the pending partial chunk into the output queue
+     * @throws StreamRuntimeException if the processor has finished or failed
+     */
+    void flush();
+
+    /**
+     * @brief Flush into the output queue and mark the input as complete
+     * @throws StreamRuntimeException if the processor has finished or failed
+     */
+    void finish();
+
+    /**
+     * @brief Move all queued output to @p output
+     * 
+     * May run on a different thread from the producer.
+     * 
+     * @param output Processed data (appended to)
+     * @return size_t Bytes drained
+     */
+    size_t drain(std::vector<uint8_t>& output);
+
+    /**
+     * @brief Hand queued output to @p sink, oldest first
+     * 
+     * Each entry leaves the queue before @p sink sees it, and the producer
+     * is not blocked while @p sink runs. May run on a different thread
+     * from the producer.
+     * 
+     * @return size_t Bytes drained
+     */
+    size_t drain(const StreamSink& sink);
+
+    /**
+     * @brief push(input) for coroutines, waiting out backpressure without a thread
+     * 
+     * The input is processed and queued as soon as the result is awaited.
+     * While flow_state() is then Paused the coroutine stays suspended, and a
+     * drain() that reopens the flow resumes it on @p executor. @p input only
+     * needs to live until the co_await completes.
+     * 
+     * @param input Next piece of input
+     * @param executor Where the coroutine continues after waiting
+     * @throws StreamRuntimeException from the co_await, as push() would
+     * 
+     * Example usage:
+     * @code
+     * co_await processor.async_push(message, executor);
+     * @endcode
+     */
+    StreamOperation async_push(std::span<const uint8_t> input, StreamExecutor& executor);
+
+    /**
+     * @brief flush() for coroutines, completing once the consumer has drained everything
+     * 
+     * @param executor Where the coroutine continues after waiting
+     * @throws StreamRuntimeException from the co_await, as flush() would
+     */
+    StreamOperation async_flush(StreamExecutor& executor);
+
+    /**
+     * @brief Replace the watermarks and transition callback
+     * 
+     * The callback runs while the queue is locked, so it must not push or
+     * drain; polling flow_state() or signalling another thread is fine.
+     * 
+     * @throws StreamInvalidArgumentException if low_watermark is not below high_watermark
+     */
+    void set_flow_control(StreamFlowControl flow);
+
+    /**
+     * @brief Whether the producer should keep pushing; safe from any thread
+     */
+    FlowState flow_state() const noexcept;
+
+    /**
+     * @brief Pending plus queued bytes, as compared with the watermarks
+     */
+    size_t buffered_bytes() const noexcept;
+
+    /**
+     * @brief Number of output entries waiting for drain()
+     */
+    size_t queue_depth() const noexcept;
+
+    /**
+     * @brief Append a compact binary snapshot of the processor's state to @p output
+     * 
+     * The snapshot holds the pending partial chunk, output queued but not
+     * yet drained, the StreamState, and the statistics counters. Blocks are
+     * encoded independently, so no codec context needs saving. A processor
+     * restarted with restore() continues the stream exactly where this one
+     * was, without reprocessing the input before the checkpoint. Flow
+     * control settings are not saved. Call from the producer, between
+     * pushes.
+     * 
+     * @param output Checkpoint bytes (appended to)
+     * 
+     * Example usage:
+     * @code
+     * std::vector<uint8_t> saved;
+     * processor.checkpoint(saved);
+     * write_file("feed.ckpt", saved);
+     * // after a restart
+     * StreamProcessor resumed(config);
+     * resumed.restore(read_file("feed.ckpt"));
+     * @endcode
+     */
+    void checkpoint(std::vector<uint8_t>& output) const;
+
+    /**
+     * @brief Replace the processor's state with one saved by checkpoint()
+     * 
+     * The checkpoint is fully validated before anything changes.
+     * 
+     * @param checkpoint Bytes produced by checkpoint()
+     * @throws StreamInvalidArgumentException if the checkpoint is corrupt,
+     *         truncated, or was taken with a different buffer size, codec,
+     *         checksum setting, level or dictionary
+     */
+    void restore(std::span<const uint8_t> checkpoint);
+
+    /**
+     * @brief Discard pending input and queued output and return to StreamState::Idle
+     * 
+     * Workers, codec state, buffers, flow control settings and statistics
+     * are kept.
+     */
+    void reset();
+
+    /**
+     * @brief Current state: Idle, Processing, Completed or Error
+     */
+    StreamState state() const noexcept;
+
+    /**
+     * @brief Input bytes held back waiting for a chunk to complete
+     */
+    size_t pending_bytes() const noexcept;
+
+    /**
+     * @brief Get processing statistics, as Stream::get_statistics()
+     * @throws StreamRuntimeException if the instance is invalid
+     */
+    StreamStats get_statistics() const;
+
+    /**
+     * @brief Get the effective configuration
+     * @throws StreamRuntimeException if the instance is invalid
+     */
+    const StreamConfig& get_config() const;
+
+    /**
+     * @brief Check if the instance is valid
+     * @return bool True if valid, false otherwise
+     */
+    bool is_valid() const noexcept;
+
+    /**
+     * @brief Get the last error message
+     * @return std::string Error message
+     */
+    std::string get_last_error() const;
+
+private:
+    friend class StreamOperation;  ///< Parks awaiting coroutines on the queue
+
+    struct Impl;  ///< Forward declaration for PIMPL idiom
+    std::unique_ptr<Impl> pimpl_;  ///< Private implementation pointer
+};
+
 /**
  * @brief Stream class
  * 
@@ -249,6 +839,14 @@ public:
      */
     Stream();
 
+    /**
+     * @brief Construct a stream with an explicit configuration
+     * @param config Stream configuration
+     * @throws StreamInvalidArgumentException if the configuration is invalid
+     * @throws StreamException on initialization failure
+     */
+    explicit Stream(const StreamConfig& config);
+
     /**
      * @brief Destructor
      */
@@ -277,6 +875,9 @@ public:
     /**
      * @brief Create a new data stream processor
      * 
+     * The processor is independent of this stream and builds its own
+     * workers and codec state from @p config.
+     * 
      * @param config Stream configuration
      * @return std::unique_ptr<StreamProcessor> Function result
      * @throws StreamException on error
@@ -288,13 +889,19 @@ public:
      * @endcode
      */
 std::unique_ptr<StreamProcessor> create_stream(
-const StreamConfig config    ) const;
+const StreamConfig& config    ) const;
 
     /**
      * @brief Process data through the stream
      * 
+     * The input is processed in chunks of StreamConfig::buffer_size and the
+     * results are appended to @p output. Storage for the whole call is
+     * reserved up front, so chunks are never reallocated individually.
+     * With StreamConfig::parallel_workers > 1, large inputs are split into
+     * blocks that run on the stream's worker pool; output order is preserved.
+     * 
      * @param input Input data to process
-     * @param output Output processed data
+     * @param output Output processed data (appended to)
      * @return void Function result
      * @throws StreamException on error
      * 
@@ -307,9 +914,141 @@ const StreamConfig config    ) const;
 void process_data(
 std::span<const uint8_t> input,std::vector<uint8_t>& output    ) const;
 
+    /**
+     * @brief Reverse process_data() for a stream with the same configuration
+     * 
+     * When the stream compresses its data, process_data() emits one
+     * self-describing block per chunk; this decodes those blocks and appends
+     * the original bytes to @p output. Streams that do not transform their
+     * data copy the input through unchanged.
+     * 
+     * @param input Data previously produced by process_data()
+     * @param output Decoded data (appended to)
+     * @throws StreamException on error, including corrupt input
+     * 
+     * Example usage:
+     * @code
+     * StreamConfig config;
+     * config.compression = CompressionType::Lz4;
+     * Stream instance(config);
+     * instance.process_data(input, encoded);
+     * instance.decode_data(encoded, decoded);
+     * @endcode
+     */
+    void decode_data(std::span<const uint8_t> input, std::vector<uint8_t>& output) const;
+
+    /**
+     * @brief Process data into segments instead of a vector
+     * 
+     * Produces exactly the bytes of process_data(input, vector), appended
+     * to @p output as segments without an intermediate copy. Pass-through
+     * streams return a view of @p input.
+     * 
+     * @param input Input data to process
+     * @param output Segments of processed data (appended to)
+     * @throws StreamRuntimeException if a max_memory budget leaves too few
+     *         free segment buffers; @p output is unchanged, and the call
+     *         can be retried once held segments are released
+     * @throws StreamException on other errors
+     */
+    void process_data(std::span<const uint8_t> input, StreamSegments& output) const;
+
+    /**
+     * @brief Process data, handing the output to @p sink window by window
+     * 
+     * Framed streams encode the input in windows of whole buffer_size chunks
+     * and pass each window's output to @p sink before starting the next, so
+     * a sink that returns quickly (such as StreamFileWriter::sink()) has its
+     * I/O overlap the encoding of the following window. Pass-through streams
+     * hand @p input to @p sink as is. The bytes delivered equal
+     * process_data(input, vector), except that deduplication only finds
+     * repeats within a window.
+     * 
+     * @param input Input data to process
+     * @param sink Receives the processed data in order
+     * @throws StreamException on error
+     * 
+     * Example usage:
+     * @code
+     * StreamFileWriter writer(fd);
+     * instance.process_data(input, writer.sink());
+     * writer.flush();
+     * @endcode
+     */
+    void process_data(std::span<const uint8_t> input, const StreamSink& sink) const;
+
+    /**
+     * @brief Process many independent messages in one call
+     *
+     * Each message is processed as if by its own process_data() call, and
+     * the results are appended to @p output back to back. The instance
+     * check, error handling, codec lock, statistics update and output
+     * growth are paid once per batch rather than once per message, which
+     * dominates the cost of small messages. With
+     * StreamConfig::parallel_workers > 1, large batches are split into runs
+     * of consecutive messages that encode on the worker pool.
+     *
+     * @param inputs Messages to process, in order
+     * @param output Processed data (appended to)
+     * @param offsets Replaced with inputs.size() + 1 positions in @p output:
+     *        message i's result is [offsets[i], offsets[i + 1])
+     * @throws StreamException on error; @p output is left as it was and
+     *         @p offsets is cleared
+     *
+     * Example usage:
+     * @code
+     * std::vector<std::span<const uint8_t>> messages = receive_messages();
+     * instance.process_batch(messages, output, offsets);
+     * for (size_t i = 0; i < messages.size(); ++i) {
+     *     send(std::span(output).subspan(offsets[i], offsets[i + 1] - offsets[i]));
+     * }
+     * @endcode
+     */
+    void process_batch(std::span<const std::span<const uint8_t>> inputs, std::vector<uint8_t>& output,
+                       std::vector<size_t>& offsets) const;
+
+    /**
+     * @brief Process a file without reading it into the heap
+     * 
+     * The file is memory mapped with sequential-access and huge-page hints
+     * and walked in windows of whole buffer_size chunks. Each window's
+     * output goes to @p sink, and the window's pages are released once the
+     * sink returns, so resident memory stays near one window regardless of
+     * file size. Pass-through streams hand the mapped pages to @p sink
+     * directly. The bytes delivered equal process_data() on the whole file.
+     * 
+     * @param path File to read
+     * @param sink Receives the processed data window by window
+     * @throws StreamRuntimeException if the file cannot be read or processing fails
+     * 
+     * Example usage:
+     * @code
+     * Stream instance(config);
+     * instance.process_file("input.bin", [&](std::span<const uint8_t> piece) {
+     *     out.write(reinterpret_cast<const char*>(piece.data()), piece.size());
+     * });
+     * @endcode
+     */
+    void process_file(const std::string& path, const StreamSink& sink) const;
+
+    /**
+     * @brief Process a file, appending the result to @p output
+     * 
+     * @p output is reserved once for the whole file, as process_data()
+     * does, and is left unchanged if the call fails.
+     * 
+     * @throws StreamRuntimeException if the file cannot be read or processing fails
+     */
+    void process_file(const std::string& path, std::vector<uint8_t>& output) const;
+
     /**
      * @brief Get stream processing statistics
      * 
+     * Counts every process_data() and decode_data() call since construction
+     * or the last reset(). Time is summed over concurrent calls, so
+     * throughput is per caller. Safe to call from any thread at any time;
+     * it never waits for calls in progress.
+     * 
      * @return StreamStats Function result
      * @throws StreamException on error
      * 
@@ -325,6 +1064,8 @@ StreamStats get_statistics(
     /**
      * @brief Reset stream processor state
      * 
+     * Zeroes the statistics reported by get_statistics().
+     * 
      * @return void Function result
      * @throws StreamException on error
      * 
@@ -338,6 +1079,13 @@ void reset(
     ) const;
 
 
+    /**
+     * @brief Get the configuration this stream was created with
+     * @return const StreamConfig& Effective configuration
+     * @throws StreamRuntimeException if the instance is invalid
+     */
+    const StreamConfig& get_config() const;
+
     /**
      * @brief Check if the instance is valid
      * @return bool True if valid, false otherwise
@@ -350,6 +1098,102 @@ void reset(
      */
     std::string get_last_error() const;
 
+private:
+    friend class StreamProcessor;  ///< Processors run on the same engine
+
+    struct Impl;  ///< Forward declaration for PIMPL idiom
+    std::unique_ptr<Impl> pimpl_;  ///< Private implementation pointer
+};
+
+/**
+ * @brief Chain of transforms that run concurrently, one thread per stage
+ * 
+ * Input is cut into chunks that flow through the stages in order. Each stage
+ * runs on its own thread and hands its output to the next over a bounded
+ * lock-free ring, so while one stage works on chunk N the stage before it is
+ * already on chunk N+1. A call takes about as long as its slowest stage
+ * rather than the sum of all of them. A stage added from a StreamConfig runs
+ * a Stream and can spread each chunk over its own parallel_workers as well.
+ * 
+ * Chunk buffers are recycled from the end of the chain back to the start,
+ * so steady-state processing does not allocate. Stages may be added until
+ * the first process() call; calls are serialized.
+ * 
+ * Example usage:
+ * @code
+ * StreamPipeline pipeline;
+ * pipeline.add_stage("filter", [](std::span<const uint8_t> in, std::vector<uint8_t>& out) {
+ *     std::copy_if(in.begin(), in.end(), std::back_inserter(out), [](uint8_t b) { return b != 0; });
+ * });
+ * pipeline.add_stage(compress_config);
+ * pipeline.process(input, writer.sink());
+ * @endcode
+ */
+class StreamPipeline {
+public:
+    /**
+     * @brief Create an empty pipeline
+     * @param chunk_size Bytes of input per chunk (0 selects DEFAULT_PIPELINE_CHUNK_SIZE)
+     * @param queue_depth Chunks queued between neighbouring stages (0 selects DEFAULT_PIPELINE_QUEUE_DEPTH)
+     */
+    explicit StreamPipeline(size_t chunk_size = DEFAULT_PIPELINE_CHUNK_SIZE,
+                            size_t queue_depth = DEFAULT_PIPELINE_QUEUE_DEPTH);
+
+    /**
+     * @brief Stop the stage threads
+     */
+    ~StreamPipeline();
+
+    StreamPipeline(const StreamPipeline&) = delete;
+    StreamPipeline& operator=(const StreamPipeline&) = delete;
+
+    StreamPipeline(StreamPipeline&& other) noexcept;
+    StreamPipeline& operator=(StreamPipeline&& other) noexcept;
+
+    /**
+     * @brief Append a stage running @p stage
+     * @param name Name used in error messages
+     * @param stage Transform applied to every chunk
+     * @return StreamPipeline& This pipeline, for chaining
+     * @throws StreamInvalidArgumentException if @p stage is empty
+     * @throws StreamRuntimeException once the pipeline has processed data
+     */
+    StreamPipeline& add_stage(std::string name, StreamStage stage);
+
+    /**
+     * @brief Append a stage that runs Stream::process_data() with @p config
+     * 
+     * With a chunk_size that is a multiple of the config's buffer_size, the
+     * stage emits exactly what process_data() would for the whole input.
+     * 
+     * @return StreamPipeline& This pipeline, for chaining
+     * @throws StreamInvalidArgumentException if @p config is invalid
+     * @throws StreamRuntimeException once the pipeline has processed data
+     */
+    StreamPipeline& add_stage(const StreamConfig& config);
+
+    /**
+     * @brief Run @p input through every stage
+     * 
+     * @p sink receives the last stage's output chunk by chunk on the calling
+     * thread. Returns once every chunk has left the pipeline, so @p input
+     * need only live for the call.
+     * 
+     * @throws StreamRuntimeException naming the stage if a stage throws;
+     *         exceptions from @p sink are rethrown unchanged
+     */
+    void process(std::span<const uint8_t> input, const StreamSink& sink);
+
+    /**
+     * @brief Run @p input through every stage, appending the result to @p output
+     */
+    void process(std::span<const uint8_t> input, std::vector<uint8_t>& output);
+
+    /**
+     * @brief Number of stages
+     */
+    size_t stage_count() const noexcept;
+
 private:
     struct Impl;  ///< Forward declaration for PIMPL idiom
     std::unique_ptr<Impl> pimpl_;  ///< Private implementation pointer
@@ -359,6 +1203,16 @@ private:
 /* Free Function Declarations                                                */
 /* ========================================================================== */
 
+/**
+ * @brief Check whether a compression algorithm is available in this build
+ * 
+ * Zstd depends on libzstd being found when the library was configured.
+ * 
+ * @param type Compression algorithm
+ * @return bool True if streams can be created with @p type
+ */
+bool is_compression_available(CompressionType type) noexcept;
+
 /**
  * @brief Get library version
  * @return std::string Version string
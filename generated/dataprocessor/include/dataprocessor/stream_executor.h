@@ -0,0 +1,220 @@
+/**
+ * @file stream_executor.h
+ * @brief Coroutine task type and executor for driving many streams from a few threads
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#ifndef STREAM_EXECUTOR_
+#define STREAM_EXECUTOR_
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace dataproc {
+
+class StreamExecutor;
+
+/**
+ * @brief Coroutine that runs on a StreamExecutor
+ *
+ * A task does nothing until it is either awaited from another task, which
+ * then resumes when it completes and sees any exception it threw, or handed
+ * to StreamExecutor::spawn(), which owns it from then on.
+ *
+ * Example usage:
+ * @code
+ * StreamTask serve(StreamProcessor& processor, Connection& connection, StreamExecutor& executor) {
+ *     while (auto message = co_await connection.read()) {
+ *         co_await processor.async_push(*message, executor);
+ *     }
+ *     co_await processor.async_flush(executor);
+ * }
+ * @endcode
+ */
+class StreamTask {
+public:
+    struct promise_type;
+
+    /**
+     * @brief Hands control to whoever is waiting for the task, or frees a spawned task
+     */
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        std::coroutine_handle<> continuation;  ///< Task awaiting this one, if any
+        StreamExecutor* executor = nullptr;  ///< Owner when spawned
+        std::exception_ptr error;
+
+        StreamTask get_return_object() noexcept {
+            return StreamTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+    };
+
+    StreamTask(StreamTask&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr))
+    {
+    }
+
+    StreamTask& operator=(StreamTask&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    StreamTask(const StreamTask&) = delete;
+    StreamTask& operator=(const StreamTask&) = delete;
+
+    ~StreamTask() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle_.promise().continuation = awaiting;
+        return handle_;
+    }
+
+    void await_resume() const {
+        if (handle_ && handle_.promise().error) {
+            std::rethrow_exception(handle_.promise().error);
+        }
+    }
+
+private:
+    friend class StreamExecutor;
+
+    explicit StreamTask(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle)
+    {
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @brief Small pool of threads that resumes coroutines
+ *
+ * Suspended coroutines cost a heap frame rather than a thread, so thousands
+ * of logical streams can wait on StreamProcessor flow control while a
+ * handful of threads run whichever ones are ready. Ready coroutines are
+ * resumed in the order they became ready.
+ *
+ * Call wait() before destroying the executor: a spawned task still
+ * suspended on something outside the executor is never resumed afterwards.
+ *
+ * Example usage:
+ * @code
+ * StreamExecutor executor(4);
+ * for (auto& connection : connections) {
+ *     executor.spawn(serve(processors[connection.id()], connection, executor));
+ * }
+ * executor.wait();
+ * @endcode
+ */
+class StreamExecutor {
+public:
+    /**
+     * @brief Awaitable that moves the awaiting coroutine onto the executor
+     */
+    struct ScheduleAwaiter {
+        StreamExecutor& executor;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const { executor.post(handle); }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Start @p threads threads, or one per hardware thread when zero
+     */
+    explicit StreamExecutor(size_t threads = 0);
+
+    /**
+     * @brief Run whatever is already queued, then stop the threads
+     */
+    ~StreamExecutor();
+
+    StreamExecutor(const StreamExecutor&) = delete;
+    StreamExecutor& operator=(const StreamExecutor&) = delete;
+
+    /**
+     * @brief Queue @p handle to be resumed on one of the executor's threads
+     *
+     * Safe from any thread, including from inside a coroutine running here.
+     */
+    void post(std::coroutine_handle<> handle);
+
+    /**
+     * @brief co_await the result to continue on one of the executor's threads
+     */
+    ScheduleAwaiter schedule() noexcept { return ScheduleAwaiter{*this}; }
+
+    /**
+     * @brief Take ownership of @p task and start it on the executor
+     */
+    void spawn(StreamTask task);
+
+    /**
+     * @brief Block until every spawned task has completed
+     *
+     * Must not be called from one of the executor's threads.
+     *
+     * @throws The first exception that escaped a spawned task since the last wait()
+     */
+    void wait();
+
+    /**
+     * @brief Number of threads resuming coroutines
+     */
+    size_t thread_count() const noexcept;
+
+private:
+    friend class StreamTask;
+
+    /**
+     * @brief Called by a spawned task as it completes, after its frame is gone
+     */
+    void task_finished(std::exception_ptr error) noexcept;
+
+    struct Impl;  ///< Forward declaration for PIMPL idiom
+    std::unique_ptr<Impl> pimpl_;  ///< Private implementation pointer
+};
+
+inline std::coroutine_handle<> StreamTask::FinalAwaiter::await_suspend(
+    std::coroutine_handle<promise_type> handle) noexcept
+{
+    promise_type& promise = handle.promise();
+    if (promise.continuation) {
+        return promise.continuation;
+    }
+    if (StreamExecutor* executor = promise.executor) {
+        std::exception_ptr error = std::move(promise.error);
+        handle.destroy();
+        executor->task_finished(std::move(error));
+    }
+    return std::noop_coroutine();
+}
+
+} // namespace dataproc
+
+#endif /* STREAM_EXECUTOR_ */
@@ -7,10 +7,20 @@
  */
 
 #include "analyzer.h"
+#include "correlation_kernel.h"
+#include "worker_pool.h"
+#include "zscore_kernel.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <sstream>
 #include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
 #include <atomic>
 #include <cassert>
 
@@ -25,6 +35,94 @@ namespace {
     std::atomic<bool> g_initialized{false};
     std::atomic<size_t> g_reference_count{0};
     std::mutex g_mutex;
+
+    /** Points scanned per outlier kernel call, bounding its index buffer */
+    constexpr size_t OUTLIER_SCAN_POINTS = 4096;
+
+    /** Standard deviations per MAD for normally distributed data: 1 / Phi^-1(3/4) */
+    constexpr double MAD_TO_STDDEV = 1.482602218505602;
+
+    /** Standard deviations per mean absolute deviation for normal data: sqrt(pi / 2) */
+    constexpr double MEAN_AD_TO_STDDEV = 1.2533141373155003;
+
+    /** Doubles per Matrix alignment unit, the granularity of Matrix::stride() */
+    constexpr size_t MATRIX_LINE = Matrix::ALIGNMENT / sizeof(double);
+
+    static_assert(MATRIX_LINE % correlation::COLUMN_ALIGNMENT == 0,
+                  "Matrix columns must satisfy the correlation kernel's alignment");
+}
+
+/* ========================================================================== */
+/* Private Helper Functions                                                  */
+/* ========================================================================== */
+
+namespace {
+    /**
+     * @brief Median of @p values, reordering them
+     */
+    double select_median(std::vector<double>& values)
+    {
+        const auto middle = values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2);
+        std::nth_element(values.begin(), middle, values.end());
+        if (values.size() % 2 != 0) {
+            return *middle;
+        }
+        // nth_element left the lower half below middle; its largest is the other middle value
+        return (*std::max_element(values.begin(), middle) + *middle) / 2.0;
+    }
+
+    /**
+     * @brief |z| that a standard normal value exceeds with probability 1 - @p confidence
+     */
+    double two_sided_normal_quantile(double confidence)
+    {
+        const double tail = 1.0 - confidence;
+        double low = 0.0;
+        double high = 40.0;
+        for (int i = 0; i < 100 && low < high; ++i) {
+            const double z = (low + high) / 2.0;
+            if (std::erfc(z / std::sqrt(2.0)) > tail) {
+                low = z;
+            } else {
+                high = z;
+            }
+        }
+        return (low + high) / 2.0;
+    }
+
+    /**
+     * @brief Write @p count values centered and scaled to unit norm into @p column
+     *
+     * @return bool False, with the column zeroed, when the variable is constant
+     *         or has non-finite samples, leaving its correlations undefined
+     */
+    bool standardize(const double* values, size_t count, double* column) noexcept
+    {
+        if (count == 0) {
+            return false;
+        }
+
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += values[i];
+        }
+        const double mean = sum / static_cast<double>(count);
+        double squares = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            const double centered = values[i] - mean;
+            column[i] = centered;
+            squares += centered * centered;
+        }
+        const double norm = std::sqrt(squares);
+        if (!(norm > 0.0) || !std::isfinite(norm)) {
+            std::fill(column, column + count, 0.0);
+            return false;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            column[i] /= norm;
+        }
+        return true;
+    }
 }
 
 /* ========================================================================== */
@@ -47,6 +145,18 @@ std::string to_string(PatternType value)
     }
 }
 
+std::string to_string(AnomalyModel value)
+{
+    switch (value) {
+        case AnomalyModel::Welford:
+            return "Welford";
+        case AnomalyModel::Ewma:
+            return "Ewma";
+        default:
+            return "Unknown";
+    }
+}
+
 
 /* ========================================================================== */
 /* Structure Operators                                                       */
@@ -61,6 +171,126 @@ bool AnalysisResult::operator!=(const AnalysisResult& other) const noexcept {
 }
 
 
+/* ========================================================================== */
+/* Matrix Implementation                                                     */
+/* ========================================================================== */
+
+MatrixView::MatrixView(const double* data, size_t rows, size_t cols, size_t stride)
+    : data_(data), rows_(rows), cols_(cols), stride_(stride)
+{
+    if (stride < rows) {
+        throw AnalyzerInvalidArgumentException("matrix stride is smaller than its row count");
+    }
+    if (data == nullptr && rows != 0 && cols != 0) {
+        throw AnalyzerInvalidArgumentException("matrix data is null");
+    }
+}
+
+MatrixView::MatrixView(const double* data, size_t rows, size_t cols)
+    : MatrixView(data, rows, cols, rows)
+{
+}
+
+MatrixView::MatrixView(const Matrix& matrix) noexcept
+    : data_(matrix.data()), rows_(matrix.rows()), cols_(matrix.cols()), stride_(matrix.stride())
+{
+}
+
+MatrixView MatrixView::block(size_t first_row, size_t first_col, size_t rows, size_t cols) const
+{
+    if (first_row > rows_ || rows > rows_ - first_row || first_col > cols_ || cols > cols_ - first_col) {
+        throw AnalyzerInvalidArgumentException("matrix block is out of range");
+    }
+    return MatrixView(data_ == nullptr ? nullptr : data_ + first_col * stride_ + first_row, rows, cols, stride_);
+}
+
+void Matrix::AlignedDelete::operator()(double* p) const noexcept
+{
+    ::operator delete(p, std::align_val_t{ALIGNMENT});
+}
+
+Matrix::Matrix(size_t rows, size_t cols)
+    : rows_(rows), cols_(cols), stride_((rows + MATRIX_LINE - 1) / MATRIX_LINE * MATRIX_LINE)
+{
+    if (stride_ < rows || (cols != 0 && stride_ > std::numeric_limits<size_t>::max() / sizeof(double) / cols)) {
+        throw AnalyzerInvalidArgumentException("matrix is too large");
+    }
+    const size_t size = stride_ * cols_;
+    if (size != 0) {
+        data_.reset(static_cast<double*>(::operator new(size * sizeof(double), std::align_val_t{ALIGNMENT})));
+        std::fill(data_.get(), data_.get() + size, 0.0);
+    }
+}
+
+Matrix::Matrix(MatrixView view)
+    : Matrix(view.rows(), view.cols())
+{
+    for (size_t c = 0; c < cols_; ++c) {
+        const std::span<const double> source = view.column(c);
+        std::copy(source.begin(), source.end(), column(c).begin());
+    }
+}
+
+Matrix Matrix::from_columns(const std::vector<std::vector<double>>& columns)
+{
+    const size_t rows = columns.empty() ? 0 : columns.front().size();
+    for (const auto& values : columns) {
+        if (values.size() != rows) {
+            throw AnalyzerInvalidArgumentException("matrix columns differ in length");
+        }
+    }
+    Matrix matrix(rows, columns.size());
+    for (size_t c = 0; c < columns.size(); ++c) {
+        std::copy(columns[c].begin(), columns[c].end(), matrix.column(c).begin());
+    }
+    return matrix;
+}
+
+Matrix::~Matrix() = default;
+
+Matrix::Matrix(const Matrix& other)
+    : Matrix(other.view())
+{
+}
+
+Matrix& Matrix::operator=(const Matrix& other)
+{
+    if (this != &other) {
+        *this = Matrix(other);
+    }
+    return *this;
+}
+
+Matrix::Matrix(Matrix&& other) noexcept
+    : data_(std::move(other.data_)),
+      rows_(std::exchange(other.rows_, 0)),
+      cols_(std::exchange(other.cols_, 0)),
+      stride_(std::exchange(other.stride_, 0))
+{
+}
+
+Matrix& Matrix::operator=(Matrix&& other) noexcept
+{
+    if (this != &other) {
+        data_ = std::move(other.data_);
+        rows_ = std::exchange(other.rows_, 0);
+        cols_ = std::exchange(other.cols_, 0);
+        stride_ = std::exchange(other.stride_, 0);
+    }
+    return *this;
+}
+
+std::vector<std::vector<double>> Matrix::to_columns() const
+{
+    std::vector<std::vector<double>> columns;
+    columns.reserve(cols_);
+    for (size_t c = 0; c < cols_; ++c) {
+        const std::span<const double> values = column(c);
+        columns.emplace_back(values.begin(), values.end());
+    }
+    return columns;
+}
+
 /* ========================================================================== */
 /* PIMPL Implementation                                                      */
 /* ========================================================================== */
@@ -70,6 +300,9 @@ struct Analyzer::Impl {
     std::string last_error;
     uint32_t magic;
 
+    std::once_flag workers_started;
+    std::unique_ptr<WorkerPool> workers;  ///< Started on first parallel call; null on a single core
+
     Impl() : valid(false), magic(MAGIC_NUMBER) {
         try {
             initialize();
@@ -110,6 +343,95 @@ struct Analyzer::Impl {
     bool is_valid() const noexcept {
         return valid && (magic == MAGIC_NUMBER);
     }
+
+    WorkerPool* worker_pool() {
+        // Most analyzers never need threads, so they are only started here
+        std::call_once(workers_started, [this] {
+            const unsigned cores = std::thread::hardware_concurrency();
+            if (cores > 1) {
+                workers = std::make_unique<WorkerPool>(cores - 1);
+            }
+        });
+        return workers.get();
+    }
+
+    /**
+     * @brief Correlation matrix of @p variables columns of @p samples values
+     *
+     * @param column_at Returns a pointer to the samples of a variable
+     */
+    template <typename ColumnAt>
+    Matrix correlate(size_t variables, size_t samples, const ColumnAt& column_at) {
+        if (variables == 0) {
+            return Matrix();
+        }
+
+        // Standardized variables as columns of Z, so that the correlation
+        // matrix is Z^T Z; padding rows and the columns that round the
+        // count up to whole tiles stay zero
+        const size_t tiles = (variables + correlation::TILE_COLUMNS - 1) / correlation::TILE_COLUMNS;
+        Matrix z(samples, tiles * correlation::TILE_COLUMNS);
+        std::vector<uint8_t> defined(variables, 0);
+
+        WorkerPool* pool = tiles > 1 ? worker_pool() : nullptr;
+        parallel_for(pool, tiles, [&](size_t tile, size_t) {
+            const size_t end = std::min((tile + 1) * correlation::TILE_COLUMNS, variables);
+            for (size_t c = tile * correlation::TILE_COLUMNS; c < end; ++c) {
+                defined[c] = standardize(column_at(c), samples, z.column(c).data()) ? 1 : 0;
+            }
+        });
+
+        // Only tiles on or above the diagonal; each also fills its mirror image
+        std::vector<std::pair<size_t, size_t>> tile_pairs;
+        tile_pairs.reserve(tiles * (tiles + 1) / 2);
+        for (size_t row = 0; row < tiles; ++row) {
+            for (size_t col = row; col < tiles; ++col) {
+                tile_pairs.emplace_back(row, col);
+            }
+        }
+        Matrix result(variables, variables);
+        const correlation::Kernel kernel = correlation::best_kernel();
+        std::vector<std::vector<double>> products(pool != nullptr ? pool->concurrency() : 1,
+                                                  std::vector<double>(correlation::TILE_COLUMNS * correlation::TILE_COLUMNS));
+        parallel_for(pool, tile_pairs.size(), [&](size_t task, size_t worker) {
+            const auto [row, col] = tile_pairs[task];
+            double* product = products[worker].data();
+            const size_t first_i = row * correlation::TILE_COLUMNS;
+            const size_t first_j = col * correlation::TILE_COLUMNS;
+            correlation::tile_product(kernel, z.column(first_i).data(), z.column(first_j).data(), z.stride(),
+                                      z.stride(), row == col, product);
+
+            const size_t end_i = std::min(first_i + correlation::TILE_COLUMNS, variables);
+            const size_t end_j = std::min(first_j + correlation::TILE_COLUMNS, variables);
+            for (size_t i = first_i; i < end_i; ++i) {
+                for (size_t j = std::max(first_j, i + 1); j < end_j; ++j) {
+                    const double value = defined[i] && defined[j]
+                        ? std::clamp(product[(i - first_i) * correlation::TILE_COLUMNS + (j - first_j)], -1.0, 1.0)
+                        : std::numeric_limits<double>::quiet_NaN();
+                    result(i, j) = value;
+                    result(j, i) = value;
+                }
+            }
+        });
+        for (size_t i = 0; i < variables; ++i) {
+            result(i, i) = defined[i] ? 1.0 : std::numeric_limits<double>::quiet_NaN();
+        }
+        return result;
+    }
+
+    /**
+     * @brief Run @p task for every index in [0, count) on @p pool, or inline when null
+     */
+    template <typename Task>
+    static void parallel_for(WorkerPool* pool, size_t count, const Task& task) {
+        if (pool != nullptr) {
+            pool->parallel_for(count, task);
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                task(i, 0);
+            }
+        }
+    }
 };
 
 /* ========================================================================== */
@@ -153,7 +475,7 @@ std::string Analyzer::get_last_error() const
 }
 
 AnalysisResult Analyzer::analyze_time_series(
-const std::vector<double> data,const std::vector<uint64_t> timestamps,const std::vector<PatternType> pattern_types) const
+const std::vector<double>& data,const std::vector<uint64_t>& timestamps,const std::vector<PatternType>& pattern_types) const
 {
     if (!is_valid()) {
         throw AnalyzerRuntimeException("Invalid analyzer instance");
@@ -163,6 +485,9 @@ const std::vector<double> data,const std::vector<uint64_t> timestamps,const std:
 
     try {
         // TODO: Implement analyze_time_series functionality
+        (void)data;
+        (void)timestamps;
+        (void)pattern_types;
         
         // Placeholder implementation
         AnalysisResult result{};
@@ -175,21 +500,60 @@ const std::vector<double> data,const std::vector<uint64_t> timestamps,const std:
 }
 
 std::vector<size_t> Analyzer::detect_anomalies(
-const std::vector<double> data,double sensitivity = 0.95) const
+const std::vector<double>& data,double sensitivity) const
+{
+    return detect_anomalies(std::span<const double>(data), sensitivity);
+}
+
+std::vector<size_t> Analyzer::detect_anomalies(std::span<const double> data, double sensitivity) const
 {
     if (!is_valid()) {
         throw AnalyzerRuntimeException("Invalid analyzer instance");
     }
 
     // Validate input parameters
+    if (!(sensitivity >= 0.0 && sensitivity < 1.0)) {
+        throw AnalyzerInvalidArgumentException("sensitivity must be in [0, 1)");
+    }
 
     try {
-        // TODO: Implement detect_anomalies functionality
-        
-        // Placeholder implementation
         std::vector<size_t> result{};
+
+        // Robust z-score: distance from the median in units of the MAD,
+        // scaled so it matches the standard deviation on normal data
+        std::vector<double> deviations;
+        deviations.reserve(data.size());
+        std::copy_if(data.begin(), data.end(), std::back_inserter(deviations),
+                     [](double value) { return std::isfinite(value); });
+        if (deviations.empty()) {
+            return result;
+        }
+        const double center = select_median(deviations);
+        zscore::absolute_deviations(deviations.data(), deviations.size(), center);
+        double spread = select_median(deviations) * MAD_TO_STDDEV;
+        if (spread == 0.0) {
+            // Over half the points sit on the median; fall back to the mean deviation
+            double sum = 0.0;
+            for (const double deviation : deviations) {
+                sum += deviation;
+            }
+            spread = sum / static_cast<double>(deviations.size()) * MEAN_AD_TO_STDDEV;
+        }
+        std::vector<double>().swap(deviations);
+        if (spread == 0.0) {
+            return result;
+        }
+
+        // |x - median| / spread > z  <=>  |x - median| > z * spread
+        const double cutoff = two_sided_normal_quantile(sensitivity) * spread;
+        size_t found[OUTLIER_SCAN_POINTS];
+        for (size_t offset = 0; offset < data.size(); offset += OUTLIER_SCAN_POINTS) {
+            const size_t count = std::min(OUTLIER_SCAN_POINTS, data.size() - offset);
+            const size_t selected = zscore::select_outliers(data.data() + offset, count, center, cutoff, offset, found);
+            result.insert(result.end(), found, found + selected);
+        }
         return result;
-        
+
     } catch (const std::exception& e) {
         pimpl_->last_error = e.what();
         throw AnalyzerRuntimeException("detect_anomalies failed: " + std::string(e.what()));
@@ -197,55 +561,250 @@ const std::vector<double> data,double sensitivity = 0.95) const
 }
 
 std::vector<std::vector<double>> Analyzer::compute_correlation_matrix(
-const std::vector<std::vector<double>> data) const
+const std::vector<std::vector<double>>& data) const
 {
     if (!is_valid()) {
         throw AnalyzerRuntimeException("Invalid analyzer instance");
     }
 
     // Validate input parameters
+    for (const auto& variable : data) {
+        if (variable.size() != data.front().size()) {
+            throw AnalyzerInvalidArgumentException("every variable must have the same number of samples");
+        }
+    }
 
     try {
-        // TODO: Implement compute_correlation_matrix functionality
-        
-        // Placeholder implementation
-        std::vector<std::vector<double>> result{};
-        return result;
-        
+        const size_t samples = data.empty() ? 0 : data.front().size();
+        const Matrix result = pimpl_->correlate(data.size(), samples,
+                                                [&data](size_t variable) { return data[variable].data(); });
+        // Symmetric, so its columns are also its rows
+        return result.to_columns();
+
     } catch (const std::exception& e) {
         pimpl_->last_error = e.what();
         throw AnalyzerRuntimeException("compute_correlation_matrix failed: " + std::string(e.what()));
     }
 }
 
+Matrix Analyzer::compute_correlation_matrix(MatrixView data) const
+{
+    if (!is_valid()) {
+        throw AnalyzerRuntimeException("Invalid analyzer instance");
+    }
+
+    try {
+        return pimpl_->correlate(data.cols(), data.rows(),
+                                 [&data](size_t variable) { return data.column(variable).data(); });
+
+    } catch (const std::exception& e) {
+        pimpl_->last_error = e.what();
+        throw AnalyzerRuntimeException("compute_correlation_matrix failed: " + std::string(e.what()));
+    }
+}
 
 /* ========================================================================== */
-/* Free Function Implementations                                             */
+/* OnlineAnomalyDetector Implementation                                       */
 /* ========================================================================== */
 
-std::string get_version()
+struct OnlineAnomalyDetector::Impl {
+    OnlineAnomalyConfig config;
+    double threshold_squared;
+    uint64_t warmup;  ///< At least two points, so there is a variance to compare against
+
+    // One entry per series, kept as separate arrays so a tick streams
+    // through each of them in order
+    std::vector<uint64_t> counts;
+    std::vector<double> means;
+    std::vector<double> spreads;  ///< Welford: sum of squared deviations; Ewma: variance
+
+    explicit Impl(const OnlineAnomalyConfig& cfg)
+        : config(cfg),
+          threshold_squared(cfg.threshold * cfg.threshold),
+          warmup(std::max<uint64_t>(cfg.warmup, 2)) {}
+
+    void ensure_series(size_t series_count) {
+        if (series_count > counts.size()) {
+            counts.resize(series_count, 0);
+            means.resize(series_count, 0.0);
+            spreads.resize(series_count, 0.0);
+        }
+    }
+
+    /**
+     * @brief Score @p value against @p series, then absorb it
+     *
+     * @param deviation Receives value - mean
+     * @param variance Receives the variance the value was scored against
+     * @return bool Whether the point is anomalous
+     */
+    template <AnomalyModel Model>
+    bool observe(size_t series, double value, double& deviation, double& variance) noexcept {
+        const uint64_t n = counts[series];
+        double& mean = means[series];
+        double& spread = spreads[series];
+
+        deviation = n == 0 ? 0.0 : value - mean;
+        if constexpr (Model == AnomalyModel::Welford) {
+            variance = n > 1 ? spread / static_cast<double>(n - 1) : 0.0;
+        } else {
+            variance = spread;
+        }
+        // Compared squared, so a flat series (variance 0) flags any change
+        const bool anomaly = n >= warmup && deviation * deviation > threshold_squared * variance;
+        if (anomaly && !config.absorb_anomalies) {
+            return true;
+        }
+
+        if (n == 0) {
+            mean = value;
+            spread = 0.0;
+        } else if constexpr (Model == AnomalyModel::Welford) {
+            const double next_mean = mean + deviation / static_cast<double>(n + 1);
+            spread += deviation * (value - next_mean);
+            mean = next_mean;
+        } else {
+            const double increment = config.alpha * deviation;
+            mean += increment;
+            spread = (1.0 - config.alpha) * (spread + deviation * increment);
+        }
+        counts[series] = n + 1;
+        return anomaly;
+    }
+
+    template <AnomalyModel Model>
+    size_t update_run(size_t series, std::span<const double> values, std::vector<size_t>& anomalies) {
+        size_t flagged = 0;
+        double deviation = 0.0;
+        double variance = 0.0;
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (std::isfinite(values[i]) && observe<Model>(series, values[i], deviation, variance)) {
+                anomalies.push_back(i);
+                ++flagged;
+            }
+        }
+        return flagged;
+    }
+
+    template <AnomalyModel Model>
+    size_t update_tick(std::span<const double> values, std::vector<size_t>& anomalies) {
+        size_t flagged = 0;
+        double deviation = 0.0;
+        double variance = 0.0;
+        for (size_t series = 0; series < values.size(); ++series) {
+            if (std::isfinite(values[series]) && observe<Model>(series, values[series], deviation, variance)) {
+                anomalies.push_back(series);
+                ++flagged;
+            }
+        }
+        return flagged;
+    }
+};
+
+OnlineAnomalyDetector::OnlineAnomalyDetector(const OnlineAnomalyConfig& config, size_t series_count)
+{
+    if (config.model != AnomalyModel::Welford && config.model != AnomalyModel::Ewma) {
+        throw AnalyzerInvalidArgumentException("unknown anomaly model");
+    }
+    if (!(config.threshold > 0.0) || !std::isfinite(config.threshold)) {
+        throw AnalyzerInvalidArgumentException("threshold must be a positive number of standard deviations");
+    }
+    if (config.model == AnomalyModel::Ewma && !(config.alpha > 0.0 && config.alpha <= 1.0)) {
+        throw AnalyzerInvalidArgumentException("alpha must be in (0, 1]");
+    }
+    pimpl_ = std::make_unique<Impl>(config);
+    pimpl_->ensure_series(series_count);
+}
+
+OnlineAnomalyDetector::~OnlineAnomalyDetector() = default;
+OnlineAnomalyDetector::OnlineAnomalyDetector(OnlineAnomalyDetector&& other) noexcept = default;
+OnlineAnomalyDetector& OnlineAnomalyDetector::operator=(OnlineAnomalyDetector&& other) noexcept = default;
+
+AnomalyVerdict OnlineAnomalyDetector::update(size_t series, double value)
+{
+    AnomalyVerdict verdict;
+    if (!std::isfinite(value)) {
+        return verdict;
+    }
+    pimpl_->ensure_series(series + 1);
+
+    double deviation = 0.0;
+    double variance = 0.0;
+    verdict.anomaly = pimpl_->config.model == AnomalyModel::Welford
+        ? pimpl_->observe<AnomalyModel::Welford>(series, value, deviation, variance)
+        : pimpl_->observe<AnomalyModel::Ewma>(series, value, deviation, variance);
+    if (variance > 0.0) {
+        verdict.score = std::abs(deviation) / std::sqrt(variance);
+    } else if (deviation != 0.0) {
+        verdict.score = std::numeric_limits<double>::infinity();
+    }
+    return verdict;
+}
+
+size_t OnlineAnomalyDetector::update(size_t series, std::span<const double> values, std::vector<size_t>& anomalies)
+{
+    if (values.empty()) {
+        return 0;
+    }
+    pimpl_->ensure_series(series + 1);
+    return pimpl_->config.model == AnomalyModel::Welford
+        ? pimpl_->update_run<AnomalyModel::Welford>(series, values, anomalies)
+        : pimpl_->update_run<AnomalyModel::Ewma>(series, values, anomalies);
+}
+
+size_t OnlineAnomalyDetector::update_all(std::span<const double> values, std::vector<size_t>& anomalies)
+{
+    pimpl_->ensure_series(values.size());
+    return pimpl_->config.model == AnomalyModel::Welford
+        ? pimpl_->update_tick<AnomalyModel::Welford>(values, anomalies)
+        : pimpl_->update_tick<AnomalyModel::Ewma>(values, anomalies);
+}
+
+size_t OnlineAnomalyDetector::series_count() const noexcept
+{
+    return pimpl_->counts.size();
+}
+
+uint64_t OnlineAnomalyDetector::count(size_t series) const noexcept
+{
+    return series < pimpl_->counts.size() ? pimpl_->counts[series] : 0;
+}
+
+double OnlineAnomalyDetector::mean(size_t series) const noexcept
+{
+    return series < pimpl_->means.size() ? pimpl_->means[series] : 0.0;
+}
+
+double OnlineAnomalyDetector::stddev(size_t series) const noexcept
+{
+    if (series >= pimpl_->counts.size()) {
+        return 0.0;
+    }
+    const uint64_t n = pimpl_->counts[series];
+    if (pimpl_->config.model == AnomalyModel::Welford) {
+        return n > 1 ? std::sqrt(pimpl_->spreads[series] / static_cast<double>(n - 1)) : 0.0;
+    }
+    return std::sqrt(pimpl_->spreads[series]);
+}
+
+void OnlineAnomalyDetector::reset(size_t series) noexcept
 {
-    return "2.1.0";
+    if (series < pimpl_->counts.size()) {
+        pimpl_->counts[series] = 0;
+        pimpl_->means[series] = 0.0;
+        pimpl_->spreads[series] = 0.0;
+    }
 }
 
-std::string get_build_info()
+const OnlineAnomalyConfig& OnlineAnomalyDetector::config() const noexcept
 {
-    std::ostringstream oss;
-    oss << "dataprocessor v2.1.0\n";
-    oss << "Built on: 2025-06-19\n";
-    oss << "Language: C++17\n";
-    oss << "Compiler: " << 
-#ifdef __clang__
-        "Clang " << __clang_major__ << "." << __clang_minor__ << "." << __clang_patchlevel__;
-#elif defined(__GNUC__)
-        "GCC " << __GNUC__ << "." << __GNUC_MINOR__ << "." << __GNUC_PATCHLEVEL__;
-#elif defined(_MSC_VER)
-        "MSVC " << _MSC_VER;
-#else
-        "Unknown";
-#endif
-    
-    return oss.str();
+    return pimpl_->config;
 }
 
+/* ========================================================================== */
+/* Free Function Implementations                                             */
+/* ========================================================================== */
+
+// get_version() and get_build_info() are shared by every module and defined in stream.cpp
+
 } // namespace dataproc
@@ -0,0 +1,480 @@
+/**
+ * @file async_writer.cpp
+ * @brief Implementation of the asynchronous file writer
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "async_writer.h"
+#include "ring_buffer.h"
+#include "stream.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ASYNC_WRITER_POSIX 1
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define ASYNC_WRITER_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace dataproc {
+
+namespace {
+    /**
+     * @brief Alignment of the write buffers, enough for O_DIRECT descriptors
+     */
+    constexpr size_t BUFFER_ALIGNMENT = 4096;
+
+    /**
+     * @brief Upper bound on pwrite() threads in the fallback backend
+     */
+    constexpr size_t MAX_PWRITE_THREADS = 4;
+
+    [[noreturn]] void throw_write_error(const std::string& action, int error)
+    {
+        throw StreamRuntimeException("cannot " + action + ": " + std::strerror(error));
+    }
+}
+
+/* ========================================================================== */
+/* io_uring Backend                                                          */
+/* ========================================================================== */
+
+#if defined(ASYNC_WRITER_IO_URING)
+
+namespace {
+
+/**
+ * @brief Writes through an io_uring instance using registered buffers
+ *
+ * Talks to the kernel with the raw system calls so no liburing is needed.
+ * Only the owning writer thread touches the rings, and it never has more
+ * requests outstanding than the rings hold, so neither ring can overflow.
+ */
+class IoUringBackend final : public WriteBackend {
+public:
+    /**
+     * @brief Set up a ring with @p count registered buffers, or return null
+     *
+     * Fails quietly when the kernel lacks io_uring, the syscalls are
+     * filtered, or the buffers cannot be registered (RLIMIT_MEMLOCK on
+     * older kernels); the caller then uses another backend.
+     */
+    static std::unique_ptr<WriteBackend> create(int target, uint8_t* buffers, size_t buffer_size, size_t count)
+    {
+        std::unique_ptr<IoUringBackend> backend(new IoUringBackend(target));
+        if (!backend->setup(static_cast<unsigned>(count))) {
+            return nullptr;
+        }
+
+        std::vector<iovec> iov(count);
+        for (size_t i = 0; i < count; ++i) {
+            iov[i].iov_base = buffers + i * buffer_size;
+            iov[i].iov_len = buffer_size;
+        }
+        if (::syscall(__NR_io_uring_register, backend->ring_fd_, IORING_REGISTER_BUFFERS,
+                      iov.data(), static_cast<unsigned>(count)) != 0) {
+            return nullptr;
+        }
+        return backend;
+    }
+
+    ~IoUringBackend() override {
+        if (sqes_ != nullptr) {
+            ::munmap(sqes_, sqes_size_);
+        }
+        if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+            ::munmap(cq_ring_, cq_ring_size_);
+        }
+        if (sq_ring_ != nullptr) {
+            ::munmap(sq_ring_, sq_ring_size_);
+        }
+        if (ring_fd_ >= 0) {
+            ::close(ring_fd_);
+        }
+    }
+
+    void submit(size_t slot, const uint8_t* data, size_t length, uint64_t offset) override {
+        const unsigned tail = *sq_tail_;
+        const unsigned index = tail & *sq_mask_;
+
+        io_uring_sqe& sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_WRITE_FIXED;
+        sqe.fd = target_;
+        sqe.addr = reinterpret_cast<uint64_t>(data);
+        sqe.len = static_cast<uint32_t>(length);
+        sqe.off = offset;
+        sqe.buf_index = static_cast<uint16_t>(slot);
+        sqe.user_data = slot;
+        sq_array_[index] = index;
+
+        // Publish the entry before the kernel can see the new tail
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        enter(1, 0, 0);
+    }
+
+    WriteCompletion wait() override {
+        for (;;) {
+            const unsigned head = *cq_head_;
+            if (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe& cqe = cqes_[head & *cq_mask_];
+                const WriteCompletion done{static_cast<size_t>(cqe.user_data), cqe.res};
+                __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+                return done;
+            }
+            enter(0, 1, IORING_ENTER_GETEVENTS);
+        }
+    }
+
+    const char* name() const noexcept override { return "io_uring"; }
+
+private:
+    explicit IoUringBackend(int target) : target_(target) {}
+
+    bool setup(unsigned entries) {
+        io_uring_params params{};
+        ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_fd_ < 0) {
+            return false;
+        }
+
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+        }
+
+        sq_ring_ = map(sq_ring_size_, IORING_OFF_SQ_RING);
+        if (sq_ring_ == nullptr) {
+            return false;
+        }
+        cq_ring_ = single_mmap ? sq_ring_ : map(cq_ring_size_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == nullptr) {
+            return false;
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+        if (sqes_ == nullptr) {
+            return false;
+        }
+
+        auto* const sq = static_cast<uint8_t*>(sq_ring_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        auto* const cq = static_cast<uint8_t*>(cq_ring_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void* map(size_t size, off_t offset) const {
+        void* const mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+        return mapping == MAP_FAILED ? nullptr : mapping;
+    }
+
+    void enter(unsigned to_submit, unsigned min_complete, unsigned flags) const {
+        while (::syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, nullptr, 0) < 0) {
+            if (errno != EINTR) {
+                throw_write_error("submit write", errno);
+            }
+        }
+    }
+
+    int target_;
+    int ring_fd_ = -1;
+    void* sq_ring_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    void* cq_ring_ = nullptr;
+    size_t cq_ring_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_mask_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned* cq_mask_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+};
+
+} // namespace
+
+#endif
+
+/* ========================================================================== */
+/* pwrite() Backend                                                          */
+/* ========================================================================== */
+
+#if defined(ASYNC_WRITER_POSIX)
+
+namespace {
+
+/**
+ * @brief Writes with blocking pwrite() calls on a few helper threads
+ *
+ * Requests and completions travel over MPMC rings sized for every request
+ * that can be outstanding, so handing work to the threads never takes a lock.
+ */
+class PwriteBackend final : public WriteBackend {
+public:
+    PwriteBackend(int target, size_t queue_depth, size_t thread_count)
+        : target_(target),
+          requests_(queue_depth + thread_count),
+          completions_(queue_depth)
+    {
+        threads_.reserve(thread_count);
+        try {
+            for (size_t i = 0; i < thread_count; ++i) {
+                threads_.emplace_back(&PwriteBackend::worker_loop, this);
+            }
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    ~PwriteBackend() override {
+        stop();
+    }
+
+    void submit(size_t slot, const uint8_t* data, size_t length, uint64_t offset) override {
+        requests_.push({slot, data, length, offset});
+    }
+
+    WriteCompletion wait() override {
+        return completions_.pop();
+    }
+
+    const char* name() const noexcept override { return "pwrite"; }
+
+private:
+    struct Request {
+        size_t slot;
+        const uint8_t* data;  ///< Null asks the thread to exit
+        size_t length;
+        uint64_t offset;
+    };
+
+    void stop() {
+        for (size_t i = 0; i < threads_.size(); ++i) {
+            requests_.push({0, nullptr, 0, 0});
+        }
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+        threads_.clear();
+    }
+
+    void worker_loop() {
+        for (;;) {
+            const Request request = requests_.pop();
+            if (request.data == nullptr) {
+                return;
+            }
+
+            ssize_t result;
+            do {
+                result = ::pwrite(target_, request.data, request.length,
+                                  static_cast<off_t>(request.offset));
+            } while (result < 0 && errno == EINTR);
+
+            completions_.push({request.slot, result < 0 ? -static_cast<int64_t>(errno) : result});
+        }
+    }
+
+    int target_;
+    std::vector<std::thread> threads_;
+    MpmcRing<Request> requests_;
+    MpmcRing<WriteCompletion> completions_;
+};
+
+} // namespace
+
+#endif
+
+/* ========================================================================== */
+/* AsyncWriter                                                               */
+/* ========================================================================== */
+
+void AsyncWriter::AlignedDelete::operator()(uint8_t* p) const noexcept
+{
+    ::operator delete(p, std::align_val_t{BUFFER_ALIGNMENT});
+}
+
+#if defined(ASYNC_WRITER_POSIX)
+
+AsyncWriter::AsyncWriter(int fd, size_t buffer_size, size_t queue_depth, bool allow_io_uring)
+    : fd_(fd), buffer_size_(buffer_size), current_(queue_depth)
+{
+    const int status = ::fcntl(fd, F_GETFL);
+    if (status < 0) {
+        throw_write_error("write to descriptor", errno);
+    }
+    if ((status & O_APPEND) != 0) {
+        // Positioned writes would land at the end in completion order
+        throw StreamRuntimeException("cannot write to descriptor: opened with O_APPEND");
+    }
+    const off_t position = ::lseek(fd, 0, SEEK_CUR);
+    if (position < 0) {
+        throw_write_error("write to descriptor", errno);
+    }
+    next_offset_ = static_cast<uint64_t>(position);
+
+    storage_.reset(static_cast<uint8_t*>(
+        ::operator new(buffer_size * queue_depth, std::align_val_t{BUFFER_ALIGNMENT})));
+    slots_.resize(queue_depth);
+    free_.reserve(queue_depth);
+    for (size_t i = 0; i < queue_depth; ++i) {
+        slots_[i].data = storage_.get() + i * buffer_size;
+        free_.push_back(queue_depth - 1 - i);
+    }
+
+#if defined(ASYNC_WRITER_IO_URING)
+    if (allow_io_uring) {
+        backend_ = IoUringBackend::create(fd, storage_.get(), buffer_size, queue_depth);
+    }
+#else
+    (void)allow_io_uring;
+#endif
+    if (!backend_) {
+        backend_ = std::make_unique<PwriteBackend>(fd, queue_depth, std::min(queue_depth, MAX_PWRITE_THREADS));
+    }
+}
+
+#else
+
+AsyncWriter::AsyncWriter(int, size_t, size_t, bool)
+    : fd_(-1), buffer_size_(0), current_(0), next_offset_(0)
+{
+    throw StreamRuntimeException("cannot write to descriptor: not supported on this platform");
+}
+
+#endif
+
+AsyncWriter::~AsyncWriter()
+{
+    try {
+        if (current_ != slots_.size() && slots_[current_].length > 0) {
+            submit(current_);
+        }
+        while (in_flight_ > 0) {
+            reap();
+        }
+    } catch (...) {
+        // Errors can only be reported through flush()
+    }
+}
+
+void AsyncWriter::write(std::span<const uint8_t> data)
+{
+    throw_if_failed();
+
+    while (!data.empty()) {
+        if (current_ == slots_.size()) {
+            while (free_.empty()) {
+                reap();
+            }
+            throw_if_failed();
+            current_ = free_.back();
+            free_.pop_back();
+            slots_[current_].length = 0;
+            slots_[current_].written = 0;
+            slots_[current_].offset = next_offset_;
+        }
+
+        Slot& slot = slots_[current_];
+        const size_t count = std::min(buffer_size_ - slot.length, data.size());
+        std::memcpy(slot.data + slot.length, data.data(), count);
+        slot.length += count;
+        next_offset_ += count;
+        queued_ += count;
+        data = data.subspan(count);
+
+        if (slot.length == buffer_size_) {
+            submit(current_);
+            current_ = slots_.size();
+        }
+    }
+}
+
+void AsyncWriter::flush()
+{
+    if (current_ != slots_.size()) {
+        if (slots_[current_].length > 0) {
+            submit(current_);
+        } else {
+            free_.push_back(current_);
+        }
+        current_ = slots_.size();
+    }
+    while (in_flight_ > 0) {
+        reap();
+    }
+    throw_if_failed();
+
+#if defined(ASYNC_WRITER_POSIX)
+    if (::lseek(fd_, static_cast<off_t>(next_offset_), SEEK_SET) < 0) {
+        throw_write_error("seek descriptor", errno);
+    }
+#endif
+}
+
+void AsyncWriter::submit(size_t slot)
+{
+    const Slot& pending = slots_[slot];
+    backend_->submit(slot, pending.data + pending.written, pending.length - pending.written,
+                     pending.offset + pending.written);
+    ++in_flight_;
+}
+
+void AsyncWriter::reap()
+{
+    const WriteCompletion done = backend_->wait();
+    --in_flight_;
+
+    Slot& slot = slots_[done.slot];
+    if (done.result <= 0) {
+        // A zero-byte write would otherwise be retried forever
+        if (error_ == 0) {
+            error_ = done.result < 0 ? static_cast<int>(-done.result) : EIO;
+        }
+        free_.push_back(done.slot);
+        return;
+    }
+
+    slot.written += static_cast<size_t>(done.result);
+    if (slot.written < slot.length) {
+        submit(done.slot);  // Short write: send the rest
+        return;
+    }
+    free_.push_back(done.slot);
+}
+
+void AsyncWriter::throw_if_failed() const
+{
+    if (error_ != 0) {
+        throw_write_error("write to descriptor", error_);
+    }
+}
+
+} // namespace dataproc
@@ -0,0 +1,510 @@
+/**
+ * @file block_codec.cpp
+ * @brief Implementation of block framing and codec dispatch
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "block_codec.h"
+#include "checksum.h"
+#include "chunker.h"
+#include "dedup_cache.h"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace dataproc {
+
+/* ========================================================================== */
+/* Private Helpers                                                           */
+/* ========================================================================== */
+
+namespace {
+    inline void store_le32(uint8_t* p, uint32_t value) noexcept
+    {
+        p[0] = static_cast<uint8_t>(value);
+        p[1] = static_cast<uint8_t>(value >> 8);
+        p[2] = static_cast<uint8_t>(value >> 16);
+        p[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    inline uint32_t load_le32(const uint8_t* p) noexcept
+    {
+        return static_cast<uint32_t>(p[0]) |
+               (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) |
+               (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    inline void store_le64(uint8_t* p, uint64_t value) noexcept
+    {
+        store_le32(p, static_cast<uint32_t>(value));
+        store_le32(p + 4, static_cast<uint32_t>(value >> 32));
+    }
+
+    inline uint64_t load_le64(const uint8_t* p) noexcept
+    {
+        return static_cast<uint64_t>(load_le32(p)) | (static_cast<uint64_t>(load_le32(p + 4)) << 32);
+    }
+
+    size_t checksum_size(uint8_t flags) noexcept
+    {
+        return (flags & (BLOCK_FLAG_CRC32C | BLOCK_FLAG_XXH64)) != 0 ? BLOCK_CHECKSUM_SIZE : 0;
+    }
+
+    uint64_t compute_checksum(uint8_t flag, const uint8_t* data, size_t size) noexcept
+    {
+        if (flag == BLOCK_FLAG_CRC32C) {
+            return checksum::crc32c(0, data, size);
+        }
+        return checksum::xxhash64(data, size);
+    }
+
+    void write_header(uint8_t* dst, const BlockHeader& header) noexcept
+    {
+        store_le32(dst, header.raw_size);
+        store_le32(dst + 4, header.stored_size);
+        dst[8] = static_cast<uint8_t>(header.codec);
+        dst[9] = header.flags;
+        dst[10] = static_cast<uint8_t>(BLOCK_MAGIC);
+        dst[11] = static_cast<uint8_t>(BLOCK_MAGIC >> 8);
+    }
+
+    [[noreturn]] void throw_corrupt(size_t offset, const std::string& reason)
+    {
+        throw StreamRuntimeException("corrupt block at offset " + std::to_string(offset) + ": " + reason);
+    }
+
+    uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+/* ========================================================================== */
+/* Shared Codec State                                                        */
+/* ========================================================================== */
+
+class CodecShared {
+public:
+    CodecShared() = default;
+    ~CodecShared()
+    {
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+        ZSTD_freeCDict(zstd_cdict);
+        ZSTD_freeDDict(zstd_ddict);
+#endif
+    }
+
+    CodecShared(const CodecShared&) = delete;
+    CodecShared& operator=(const CodecShared&) = delete;
+
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+    ZSTD_CDict* zstd_cdict = nullptr;
+    ZSTD_DDict* zstd_ddict = nullptr;
+#endif
+};
+
+std::shared_ptr<const CodecShared> make_codec_shared(const StreamConfig& config)
+{
+    auto shared = std::make_shared<CodecShared>();
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+    if (config.compression == CompressionType::Zstd && !config.dictionary.empty()) {
+        shared->zstd_cdict = ZSTD_createCDict(config.dictionary.data(), config.dictionary.size(),
+                                              config.compression_level);
+        shared->zstd_ddict = ZSTD_createDDict(config.dictionary.data(), config.dictionary.size());
+        if (shared->zstd_cdict == nullptr || shared->zstd_ddict == nullptr) {
+            throw StreamRuntimeException("failed to load Zstandard dictionary");
+        }
+    }
+#else
+    (void)config;
+#endif
+    return shared;
+}
+
+/* ========================================================================== */
+/* Functions                                                                 */
+/* ========================================================================== */
+
+bool uses_block_framing(const StreamConfig& config) noexcept
+{
+    return config.compression != CompressionType::None || config.enable_checksum ||
+           config.chunking == ChunkingMode::ContentDefined || config.dedup_cache_entries != 0;
+}
+
+void validate_codec_config(const StreamConfig& config)
+{
+    if (!is_compression_available(config.compression)) {
+        throw StreamInvalidArgumentException(
+            to_string(config.compression) + " compression is not available in this build");
+    }
+
+    if (!config.dictionary.empty() && config.compression != CompressionType::Zstd) {
+        throw StreamInvalidArgumentException("dictionaries are only supported with Zstd compression");
+    }
+
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+    if (config.compression == CompressionType::Zstd &&
+        (config.compression_level < ZSTD_minCLevel() || config.compression_level > ZSTD_maxCLevel())) {
+        throw StreamInvalidArgumentException(
+            "compression_level must be between " + std::to_string(ZSTD_minCLevel()) +
+            " and " + std::to_string(ZSTD_maxCLevel()));
+    }
+#endif
+
+    if (config.chunking == ChunkingMode::ContentDefined && config.buffer_size < MIN_CONTENT_CHUNK_BUFFER) {
+        throw StreamInvalidArgumentException(
+            "content-defined chunking needs a buffer_size of at least " + std::to_string(MIN_CONTENT_CHUNK_BUFFER));
+    }
+
+    if (config.dedup_cache_entries > MAX_DEDUP_CACHE_ENTRIES) {
+        throw StreamInvalidArgumentException(
+            "dedup_cache_entries exceeds the maximum of " + std::to_string(MAX_DEDUP_CACHE_ENTRIES));
+    }
+
+    if (uses_block_framing(config) && config.buffer_size > MAX_BLOCK_SIZE) {
+        throw StreamInvalidArgumentException(
+            "buffer_size exceeds the maximum block size of " + std::to_string(MAX_BLOCK_SIZE));
+    }
+}
+
+size_t max_encoded_block_size(const StreamConfig& config, size_t raw_size) noexcept
+{
+    size_t payload = raw_size;
+    if (config.compression == CompressionType::Lz4) {
+        payload = lz4::compress_bound(raw_size);
+    }
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+    if (config.compression == CompressionType::Zstd) {
+        payload = ZSTD_compressBound(raw_size);
+    }
+#endif
+    return BLOCK_HEADER_SIZE + (config.enable_checksum ? BLOCK_CHECKSUM_SIZE : 0) + payload;
+}
+
+size_t scan_frame(std::span<const uint8_t> frame, std::vector<FrameBlock>& blocks)
+{
+    blocks.clear();
+
+    size_t offset = 0;
+    size_t raw_total = 0;
+    while (offset < frame.size()) {
+        if (frame.size() - offset < BLOCK_HEADER_SIZE) {
+            throw_corrupt(offset, "truncated header");
+        }
+
+        const uint8_t* const p = frame.data() + offset;
+        const uint16_t magic = static_cast<uint16_t>(p[10] | (p[11] << 8));
+        if (magic != BLOCK_MAGIC) {
+            throw_corrupt(offset, "bad magic");
+        }
+
+        FrameBlock block{};
+        block.input_offset = offset;
+        block.raw_offset = raw_total;
+        block.header.raw_size = load_le32(p);
+        block.header.stored_size = load_le32(p + 4);
+        block.header.codec = static_cast<BlockCodecId>(p[8]);
+        block.header.flags = p[9];
+
+        if (block.header.flags != 0 && block.header.flags != BLOCK_FLAG_CRC32C &&
+            block.header.flags != BLOCK_FLAG_XXH64) {
+            throw_corrupt(offset, "unknown flags");
+        }
+        if (block.header.raw_size > MAX_BLOCK_SIZE) {
+            throw_corrupt(offset, "block too large");
+        }
+        const size_t prefix = BLOCK_HEADER_SIZE + checksum_size(block.header.flags);
+        if (frame.size() - offset < prefix || frame.size() - offset - prefix < block.header.stored_size) {
+            throw_corrupt(offset, "truncated payload");
+        }
+
+        block.payload_offset = offset + prefix;
+        if (block.header.codec == BlockCodecId::Reference) {
+            if (block.header.stored_size != BLOCK_REFERENCE_SIZE) {
+                throw_corrupt(offset, "reference size mismatch");
+            }
+            const uint32_t distance = load_le32(frame.data() + block.payload_offset);
+            if (distance == 0 || distance > blocks.size()) {
+                throw_corrupt(offset, "reference outside the frame");
+            }
+            const FrameBlock& source = blocks[blocks.size() - distance];
+            if (source.header.codec == BlockCodecId::Reference || source.header.raw_size != block.header.raw_size) {
+                throw_corrupt(offset, "reference to a mismatched block");
+            }
+            block.source_offset = source.raw_offset;
+        }
+        blocks.push_back(block);
+        offset += prefix + block.header.stored_size;
+        raw_total += block.header.raw_size;
+    }
+
+    return raw_total;
+}
+
+/* ========================================================================== */
+/* CodecCounters                                                             */
+/* ========================================================================== */
+
+CodecCounters::CodecCounters(const CodecCounters& other) noexcept
+    : raw_bytes(other.raw_bytes.load(std::memory_order_relaxed)),
+      encoded_bytes(other.encoded_bytes.load(std::memory_order_relaxed)),
+      codec_ns(other.codec_ns.load(std::memory_order_relaxed))
+{
+}
+
+CodecCounters& CodecCounters::operator=(const CodecCounters& other) noexcept
+{
+    raw_bytes.store(other.raw_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    encoded_bytes.store(other.encoded_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    codec_ns.store(other.codec_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+void CodecCounters::add(uint64_t raw, uint64_t encoded, uint64_t ns) noexcept
+{
+    raw_bytes.fetch_add(raw, std::memory_order_relaxed);
+    encoded_bytes.fetch_add(encoded, std::memory_order_relaxed);
+    codec_ns.fetch_add(ns, std::memory_order_relaxed);
+}
+
+void CodecCounters::reset() noexcept
+{
+    raw_bytes.store(0, std::memory_order_relaxed);
+    encoded_bytes.store(0, std::memory_order_relaxed);
+    codec_ns.store(0, std::memory_order_relaxed);
+}
+
+/* ========================================================================== */
+/* BlockEncoder                                                              */
+/* ========================================================================== */
+
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+struct BlockEncoder::ZstdContext {
+    ZSTD_CCtx* cctx = ZSTD_createCCtx();
+    ~ZstdContext() { ZSTD_freeCCtx(cctx); }
+};
+
+struct BlockDecoder::ZstdContext {
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    ~ZstdContext() { ZSTD_freeDCtx(dctx); }
+};
+#else
+struct BlockEncoder::ZstdContext {};
+struct BlockDecoder::ZstdContext {};
+#endif
+
+BlockEncoder::BlockEncoder(const StreamConfig& config, std::shared_ptr<const CodecShared> shared)
+    : compression_(config.compression),
+      level_(config.compression_level),
+      checksum_flag_(0),
+      shared_(std::move(shared))
+{
+    if (config.enable_checksum) {
+        checksum_flag_ = checksum::crc32c_accelerated() ? BLOCK_FLAG_CRC32C : BLOCK_FLAG_XXH64;
+    }
+    if (compression_ == CompressionType::Lz4) {
+        lz4_state_ = std::make_unique<lz4::CompressState>();
+    }
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+    if (compression_ == CompressionType::Zstd) {
+        zstd_ = std::make_unique<ZstdContext>();
+        if (zstd_->cctx == nullptr) {
+            throw StreamRuntimeException("failed to create Zstandard compression context");
+        }
+    }
+#endif
+}
+
+BlockEncoder::~BlockEncoder() = default;
+BlockEncoder::BlockEncoder(BlockEncoder&&) noexcept = default;
+BlockEncoder& BlockEncoder::operator=(BlockEncoder&&) noexcept = default;
+
+size_t BlockEncoder::encode(std::span<const uint8_t> raw, uint8_t* dst)
+{
+    const size_t prefix = BLOCK_HEADER_SIZE + checksum_size(checksum_flag_);
+    uint8_t* const payload = dst + prefix;
+
+    BlockHeader header{};
+    header.raw_size = static_cast<uint32_t>(raw.size());
+    header.codec = BlockCodecId::Stored;
+    header.flags = checksum_flag_;
+
+    // Checksum the input while it is still hot in cache from the caller
+    if (checksum_flag_ != 0) {
+        store_le64(dst + BLOCK_HEADER_SIZE, compute_checksum(checksum_flag_, raw.data(), raw.size()));
+    }
+
+    size_t stored_size = raw.size();
+    const auto start = std::chrono::steady_clock::now();
+    if (compression_ == CompressionType::Lz4) {
+        const size_t compressed = lz4::compress(*lz4_state_, raw.data(), raw.size(), payload);
+        if (compressed < raw.size()) {
+            header.codec = BlockCodecId::Lz4;
+            stored_size = compressed;
+        }
+    }
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+    if (compression_ == CompressionType::Zstd) {
+        const size_t capacity = ZSTD_compressBound(raw.size());
+        const size_t compressed = shared_->zstd_cdict != nullptr
+            ? ZSTD_compress_usingCDict(zstd_->cctx, payload, capacity, raw.data(), raw.size(),
+                                       shared_->zstd_cdict)
+            : ZSTD_compressCCtx(zstd_->cctx, payload, capacity, raw.data(), raw.size(), level_);
+        if (ZSTD_isError(compressed)) {
+            throw StreamRuntimeException(std::string("Zstandard compression failed: ") +
+                                         ZSTD_getErrorName(compressed));
+        }
+        if (compressed < raw.size()) {
+            header.codec = BlockCodecId::Zstd;
+            stored_size = compressed;
+        }
+    }
+#endif
+    const uint64_t codec_ns = elapsed_ns(start);
+
+    // Incompressible data is stored as-is so decoding it is a plain copy
+    if (header.codec == BlockCodecId::Stored && !raw.empty()) {
+        std::memcpy(payload, raw.data(), raw.size());
+    }
+
+    header.stored_size = static_cast<uint32_t>(stored_size);
+    write_header(dst, header);
+
+    counters_.add(raw.size(), prefix + stored_size, codec_ns);
+    return prefix + stored_size;
+}
+
+size_t BlockEncoder::encode_reference(std::span<const uint8_t> raw, uint32_t distance, uint8_t* dst) noexcept
+{
+    const size_t prefix = BLOCK_HEADER_SIZE + checksum_size(checksum_flag_);
+
+    BlockHeader header{};
+    header.raw_size = static_cast<uint32_t>(raw.size());
+    header.stored_size = static_cast<uint32_t>(BLOCK_REFERENCE_SIZE);
+    header.codec = BlockCodecId::Reference;
+    header.flags = checksum_flag_;
+    write_header(dst, header);
+
+    // The checksum covers the repeated contents, so decoding still verifies them
+    if (checksum_flag_ != 0) {
+        store_le64(dst + BLOCK_HEADER_SIZE, compute_checksum(checksum_flag_, raw.data(), raw.size()));
+    }
+    store_le32(dst + prefix, distance);
+
+    counters_.add(raw.size(), prefix + BLOCK_REFERENCE_SIZE, 0);
+    return prefix + BLOCK_REFERENCE_SIZE;
+}
+
+/* ========================================================================== */
+/* BlockDecoder                                                              */
+/* ========================================================================== */
+
+BlockDecoder::BlockDecoder(const StreamConfig& config, std::shared_ptr<const CodecShared> shared)
+    : shared_(std::move(shared))
+{
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+    if (config.compression == CompressionType::Zstd) {
+        zstd_ = std::make_unique<ZstdContext>();
+        if (zstd_->dctx == nullptr) {
+            throw StreamRuntimeException("failed to create Zstandard decompression context");
+        }
+    }
+#else
+    (void)config;
+#endif
+}
+
+BlockDecoder::~BlockDecoder() = default;
+BlockDecoder::BlockDecoder(BlockDecoder&&) noexcept = default;
+BlockDecoder& BlockDecoder::operator=(BlockDecoder&&) noexcept = default;
+
+void BlockDecoder::decode(std::span<const uint8_t> frame, const FrameBlock& block, uint8_t* dst)
+{
+    const uint8_t* const payload = frame.data() + block.payload_offset;
+    const BlockHeader& header = block.header;
+
+    const auto start = std::chrono::steady_clock::now();
+    switch (header.codec) {
+        case BlockCodecId::Stored:
+            if (header.stored_size != header.raw_size) {
+                throw_corrupt(block.input_offset, "stored size mismatch");
+            }
+            if (header.raw_size != 0) {
+                std::memcpy(dst, payload, header.raw_size);
+            }
+            break;
+        case BlockCodecId::Reference:
+            // scan_frame() checked the source: an earlier block of the same size
+            std::memcpy(dst, dst - (block.raw_offset - block.source_offset), header.raw_size);
+            break;
+        case BlockCodecId::Lz4:
+            if (!lz4::decompress(payload, header.stored_size, dst, header.raw_size)) {
+                throw_corrupt(block.input_offset, "invalid LZ4 payload");
+            }
+            break;
+        case BlockCodecId::Zstd: {
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+            if (!zstd_) {
+                throw_corrupt(block.input_offset, "Zstandard block in a stream not configured for Zstd");
+            }
+            const size_t decoded = shared_->zstd_ddict != nullptr
+                ? ZSTD_decompress_usingDDict(zstd_->dctx, dst, header.raw_size, payload,
+                                             header.stored_size, shared_->zstd_ddict)
+                : ZSTD_decompressDCtx(zstd_->dctx, dst, header.raw_size, payload, header.stored_size);
+            if (ZSTD_isError(decoded)) {
+                throw_corrupt(block.input_offset, ZSTD_getErrorName(decoded));
+            }
+            if (decoded != header.raw_size) {
+                throw_corrupt(block.input_offset, "Zstandard payload size mismatch");
+            }
+#else
+            throw_corrupt(block.input_offset, "Zstandard support is not available in this build");
+#endif
+            break;
+        }
+        default:
+            throw_corrupt(block.input_offset, "unknown codec");
+    }
+    const uint64_t codec_ns = elapsed_ns(start);
+
+    if (header.flags != 0) {
+        const uint64_t expected = load_le64(frame.data() + block.input_offset + BLOCK_HEADER_SIZE);
+        if (compute_checksum(header.flags, dst, header.raw_size) != expected) {
+            throw_corrupt(block.input_offset, "checksum mismatch");
+        }
+    }
+
+    counters_.add(header.raw_size, block.payload_offset - block.input_offset + header.stored_size, codec_ns);
+}
+
+/* ========================================================================== */
+/* Codec Availability                                                        */
+/* ========================================================================== */
+
+bool is_compression_available(CompressionType type) noexcept
+{
+    switch (type) {
+        case CompressionType::None:
+        case CompressionType::Lz4:
+            return true;
+        case CompressionType::Zstd:
+#if defined(DATAPROCESSOR_HAVE_ZSTD)
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+} // namespace dataproc
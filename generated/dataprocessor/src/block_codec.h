@@ -0,0 +1,254 @@
+/**
+ * @file block_codec.h
+ * @brief Block framing and codec dispatch for the stream module
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ *
+ * When a stream transforms its data (compression, checksums, ...) every
+ * chunk of StreamConfig::buffer_size input bytes becomes one self-describing
+ * block. A block is a fixed little-endian header followed by its payload:
+ *
+ *   offset  size  field
+ *   0       4     raw_size     decoded size of the block
+ *   4       4     stored_size  payload bytes following the header
+ *   8       1     codec        BlockCodecId used for the payload
+ *   9       1     flags        BLOCK_FLAG_* bits, all others must be zero
+ *   10      2     magic        BLOCK_MAGIC
+ *
+ * When a checksum flag is set, an 8-byte little-endian checksum of the
+ * decoded block follows the header, ahead of the payload. CRC32C values are
+ * zero-extended to 64 bits.
+ *
+ * Blocks are independent of each other, so they can be encoded and decoded
+ * in any order and on any thread. The exception is a Reference block, which
+ * repeats an earlier block of the same frame: its 4-byte payload is the
+ * distance back, in blocks, to a block that is not itself a reference. It is
+ * resolved by copying once that block has been decoded.
+ */
+
+#ifndef BLOCK_CODEC_
+#define BLOCK_CODEC_
+
+#include "stream.h"
+#include "lz4_codec.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace dataproc {
+
+/* ========================================================================== */
+/* Constants and Types                                                        */
+/* ========================================================================== */
+
+constexpr size_t BLOCK_HEADER_SIZE = 12;
+constexpr uint16_t BLOCK_MAGIC = 0xB10C;
+constexpr size_t BLOCK_CHECKSUM_SIZE = 8;
+
+constexpr uint8_t BLOCK_FLAG_CRC32C = 0x01;  ///< Followed by a CRC32C of the decoded block
+constexpr uint8_t BLOCK_FLAG_XXH64 = 0x02;  ///< Followed by an xxHash64 of the decoded block
+
+/**
+ * @brief Largest buffer_size accepted for framed streams
+ */
+constexpr size_t MAX_BLOCK_SIZE = size_t{1} << 30;
+
+/**
+ * @brief Payload encoding recorded in a block header
+ */
+enum class BlockCodecId : uint8_t {
+    Stored = 0,  ///< Payload is the raw data
+    Lz4 = 1,  ///< Payload is an LZ4 block
+    Zstd = 2,  ///< Payload is a Zstandard frame
+    Reference = 3,  ///< Payload is the distance back to an identical block
+};
+
+constexpr size_t BLOCK_REFERENCE_SIZE = 4;
+
+/**
+ * @brief Decoded block header
+ */
+struct BlockHeader {
+    uint32_t raw_size;
+    uint32_t stored_size;
+    BlockCodecId codec;
+    uint8_t flags;
+};
+
+/**
+ * @brief Location of one block inside an encoded frame
+ */
+struct FrameBlock {
+    size_t input_offset;  ///< Offset of the block header in the encoded input
+    size_t raw_offset;  ///< Offset of the decoded block in the decoded output
+    size_t payload_offset;  ///< Offset of the payload in the encoded input
+    size_t source_offset;  ///< For Reference blocks, raw_offset of the block repeated
+    BlockHeader header;
+};
+
+/* ========================================================================== */
+/* Functions                                                                  */
+/* ========================================================================== */
+
+/**
+ * @brief Whether streams with @p config emit framed blocks or raw bytes
+ */
+bool uses_block_framing(const StreamConfig& config) noexcept;
+
+/**
+ * @brief Reject configurations the block codecs cannot honour
+ * @throws StreamInvalidArgumentException describing the problem
+ */
+void validate_codec_config(const StreamConfig& config);
+
+/**
+ * @brief Codec state shared read-only by all encoders and decoders of a stream
+ *
+ * Holds digested dictionaries, which are expensive to build and safe to use
+ * from several threads at once.
+ */
+class CodecShared;
+
+/**
+ * @brief Build the shared codec state for @p config
+ * @throws StreamRuntimeException if a dictionary cannot be loaded
+ */
+std::shared_ptr<const CodecShared> make_codec_shared(const StreamConfig& config);
+
+/**
+ * @brief Upper bound of the encoded size (header included) of one block
+ */
+size_t max_encoded_block_size(const StreamConfig& config, size_t raw_size) noexcept;
+
+/**
+ * @brief Walk the headers of an encoded frame
+ *
+ * @param frame Encoded bytes, a concatenation of whole blocks
+ * @param blocks Receives the location of every block (cleared first)
+ * @return size_t Total decoded size of the frame
+ * @throws StreamRuntimeException if the frame is truncated or malformed, or
+ *         a reference points outside it or at another reference
+ */
+size_t scan_frame(std::span<const uint8_t> frame, std::vector<FrameBlock>& blocks);
+
+/* ========================================================================== */
+/* Encoder and Decoder                                                        */
+/* ========================================================================== */
+
+/**
+ * @brief Work done by one encoder or decoder
+ *
+ * Only the owning thread adds to these, but statistics readers load them at
+ * any time without locking, so they are relaxed atomics on a cache line of
+ * their own.
+ */
+struct alignas(64) CodecCounters {
+    std::atomic<uint64_t> raw_bytes{0};  ///< Decoded-side bytes
+    std::atomic<uint64_t> encoded_bytes{0};  ///< Encoded-side bytes, headers included
+    std::atomic<uint64_t> codec_ns{0};  ///< Time spent inside compression libraries
+
+    CodecCounters() = default;
+    CodecCounters(const CodecCounters& other) noexcept;
+    CodecCounters& operator=(const CodecCounters& other) noexcept;
+
+    void add(uint64_t raw, uint64_t encoded, uint64_t ns) noexcept;
+    void reset() noexcept;
+};
+
+/**
+ * @brief Per-thread block encoder holding reusable codec state
+ */
+class BlockEncoder {
+public:
+    BlockEncoder(const StreamConfig& config, std::shared_ptr<const CodecShared> shared);
+    ~BlockEncoder();
+    BlockEncoder(BlockEncoder&&) noexcept;
+    BlockEncoder& operator=(BlockEncoder&&) noexcept;
+
+    /**
+     * @brief Block flag of the checksum this encoder writes (0 for none)
+     *
+     * CRC32C is chosen when the CPU computes it in hardware, xxHash64
+     * otherwise. Decoders verify either.
+     */
+    uint8_t checksum_flag() const noexcept { return checksum_flag_; }
+
+    /**
+     * @brief Encode one block (header included)
+     * @param raw Block contents, at most MAX_BLOCK_SIZE bytes
+     * @param dst Buffer of at least max_encoded_block_size() bytes
+     * @return size_t Bytes written to @p dst
+     * @throws StreamRuntimeException if the codec fails
+     */
+    size_t encode(std::span<const uint8_t> raw, uint8_t* dst);
+
+    /**
+     * @brief Encode @p raw as a reference to the identical block @p distance blocks back
+     * @param raw Block contents, checksummed like any other block
+     * @param distance Blocks back to the original, at least 1
+     * @param dst Buffer of at least max_encoded_block_size() bytes
+     * @return size_t Bytes written to @p dst
+     */
+    size_t encode_reference(std::span<const uint8_t> raw, uint32_t distance, uint8_t* dst) noexcept;
+
+    const CodecCounters& counters() const noexcept { return counters_; }
+    void reset_counters() noexcept { counters_.reset(); }
+    void add_counters(uint64_t raw, uint64_t encoded, uint64_t ns) noexcept { counters_.add(raw, encoded, ns); }
+
+private:
+    struct ZstdContext;
+
+    CompressionType compression_;
+    int level_;
+    uint8_t checksum_flag_;
+    std::shared_ptr<const CodecShared> shared_;
+    std::unique_ptr<lz4::CompressState> lz4_state_;
+    std::unique_ptr<ZstdContext> zstd_;
+    CodecCounters counters_;
+};
+
+/**
+ * @brief Per-thread block decoder holding reusable codec state
+ */
+class BlockDecoder {
+public:
+    BlockDecoder(const StreamConfig& config, std::shared_ptr<const CodecShared> shared);
+    ~BlockDecoder();
+    BlockDecoder(BlockDecoder&&) noexcept;
+    BlockDecoder& operator=(BlockDecoder&&) noexcept;
+
+    /**
+     * @brief Decode one block located by scan_frame()
+     *
+     * @p dst lies in the frame's decoded output, so a Reference block copies
+     * from the block it repeats, which must already be decoded.
+     *
+     * @param frame The frame that was scanned
+     * @param block Block to decode
+     * @param dst Position of the block in the decoded output, exactly
+     *            block.header.raw_size bytes
+     * @throws StreamRuntimeException if the payload is corrupt or does not
+     *         match the block's checksum
+     */
+    void decode(std::span<const uint8_t> frame, const FrameBlock& block, uint8_t* dst);
+
+    const CodecCounters& counters() const noexcept { return counters_; }
+    void reset_counters() noexcept { counters_.reset(); }
+    void add_counters(uint64_t raw, uint64_t encoded, uint64_t ns) noexcept { counters_.add(raw, encoded, ns); }
+
+private:
+    struct ZstdContext;
+
+    std::shared_ptr<const CodecShared> shared_;
+    std::unique_ptr<ZstdContext> zstd_;
+    CodecCounters counters_;
+};
+
+} // namespace dataproc
+
+#endif /* BLOCK_CODEC_ */
@@ -0,0 +1,97 @@
+/**
+ * @file buffer_pool.cpp
+ * @brief Implementation of the bounded buffer pool
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "buffer_pool.h"
+
+#include <cassert>
+#include <utility>
+
+namespace dataproc {
+
+/* ========================================================================== */
+/* Lease                                                                     */
+/* ========================================================================== */
+
+BufferPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(std::exchange(other.pool_, nullptr)),
+      data_(std::exchange(other.data_, nullptr))
+{
+}
+
+BufferPool::Lease& BufferPool::Lease::operator=(Lease&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        pool_ = std::exchange(other.pool_, nullptr);
+        data_ = std::exchange(other.data_, nullptr);
+    }
+    return *this;
+}
+
+size_t BufferPool::Lease::size() const noexcept
+{
+    return pool_ ? pool_->buffer_size() : 0;
+}
+
+void BufferPool::Lease::release() noexcept
+{
+    if (data_ != nullptr) {
+        pool_->give_back(data_);
+        data_ = nullptr;
+        pool_ = nullptr;
+    }
+}
+
+/* ========================================================================== */
+/* BufferPool                                                                */
+/* ========================================================================== */
+
+BufferPool::BufferPool(size_t buffer_size, size_t buffer_count)
+    : buffer_size_(buffer_size),
+      capacity_(buffer_count),
+      // Default-initialized, so pages are only committed once a buffer is used
+      storage_(new uint8_t[buffer_size * buffer_count]),
+      free_(buffer_count)
+{
+    for (size_t i = 0; i < buffer_count; ++i) {
+        uint8_t* data = storage_.get() + i * buffer_size;
+        free_.try_push(data);
+    }
+}
+
+BufferPool::~BufferPool()
+{
+    assert(free_.size() == capacity_ && "BufferPool destroyed with outstanding leases");
+}
+
+size_t BufferPool::available() const
+{
+    return free_.size();
+}
+
+BufferPool::Lease BufferPool::acquire()
+{
+    return Lease(this, free_.pop());
+}
+
+BufferPool::Lease BufferPool::try_acquire()
+{
+    uint8_t* data = nullptr;
+    if (!free_.try_pop(data)) {
+        return Lease();
+    }
+    return Lease(this, data);
+}
+
+void BufferPool::give_back(uint8_t* data) noexcept
+{
+    // Cannot fail: the ring holds every buffer the pool owns
+    free_.try_push(data);
+}
+
+} // namespace dataproc
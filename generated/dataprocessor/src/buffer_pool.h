@@ -0,0 +1,111 @@
+/**
+ * @file buffer_pool.h
+ * @brief Bounded pool of reusable working buffers used by the stream module
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#ifndef BUFFER_POOL_
+#define BUFFER_POOL_
+
+#include "ring_buffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace dataproc {
+
+/**
+ * @brief Fixed number of equally sized buffers carved from one allocation
+ *
+ * The whole pool is allocated up front and never grows, so the memory a
+ * stream uses for working buffers is bounded by buffer_size() * capacity()
+ * however much input arrives. When every buffer is leased, acquire() blocks
+ * until one is returned and try_acquire() reports the shortage instead.
+ * The free list is a lock-free MPMC ring, so workers leasing and returning
+ * buffers concurrently never serialize on a lock.
+ */
+class BufferPool {
+public:
+    /**
+     * @brief Exclusive use of one buffer, returned to the pool on destruction
+     */
+    class Lease {
+    public:
+        Lease() = default;
+        ~Lease() { release(); }
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        uint8_t* data() const noexcept { return data_; }
+        size_t size() const noexcept;
+
+        /**
+         * @brief Whether this lease holds a buffer
+         */
+        explicit operator bool() const noexcept { return data_ != nullptr; }
+
+        /**
+         * @brief Return the buffer to the pool early
+         */
+        void release() noexcept;
+
+    private:
+        friend class BufferPool;
+        Lease(BufferPool* pool, uint8_t* data) noexcept : pool_(pool), data_(data) {}
+
+        BufferPool* pool_ = nullptr;
+        uint8_t* data_ = nullptr;
+    };
+
+    /**
+     * @brief Allocate @p buffer_count buffers of @p buffer_size bytes each
+     * @throws std::bad_alloc if the storage cannot be allocated
+     */
+    BufferPool(size_t buffer_size, size_t buffer_count);
+
+    /**
+     * @brief Destroy the pool; every lease must have been released
+     */
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    size_t buffer_size() const noexcept { return buffer_size_; }
+    size_t capacity() const noexcept { return capacity_; }
+
+    /**
+     * @brief Number of buffers not currently leased
+     */
+    size_t available() const;
+
+    /**
+     * @brief Lease a buffer, waiting for one to be released if none is free
+     */
+    Lease acquire();
+
+    /**
+     * @brief Lease a buffer if one is free
+     * @return Lease An empty lease when the pool is exhausted
+     */
+    Lease try_acquire();
+
+private:
+    void give_back(uint8_t* data) noexcept;
+
+    size_t buffer_size_;
+    size_t capacity_;
+    std::unique_ptr<uint8_t[]> storage_;
+
+    MpmcRing<uint8_t*> free_;
+};
+
+} // namespace dataproc
+
+#endif /* BUFFER_POOL_ */
@@ -0,0 +1,334 @@
+/**
+ * @file checksum.cpp
+ * @brief Implementation of the block checksums
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "checksum.h"
+
+#include <bit>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CHECKSUM_SSE42_DISPATCH 1
+#include <nmmintrin.h>
+#endif
+
+namespace dataproc {
+namespace checksum {
+
+/* ========================================================================== */
+/* Private Constants and Helpers                                             */
+/* ========================================================================== */
+
+namespace {
+    constexpr uint32_t CRC32C_POLY = 0x82F63B78;  ///< Castagnoli polynomial, bit reflected
+
+    inline uint32_t load_le32(const uint8_t* p) noexcept
+    {
+        return static_cast<uint32_t>(p[0]) |
+               (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) |
+               (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    inline uint64_t load_le64(const uint8_t* p) noexcept
+    {
+        return static_cast<uint64_t>(load_le32(p)) | (static_cast<uint64_t>(load_le32(p + 4)) << 32);
+    }
+
+    /**
+     * @brief Slicing-by-8 lookup tables
+     *
+     * table[0] is the classic byte-at-a-time table; table[k] advances a byte
+     * through k further zero bytes, so eight bytes are folded per step.
+     */
+    struct Crc32cTables {
+        uint32_t table[8][256];
+    };
+
+    constexpr Crc32cTables make_crc32c_tables() noexcept
+    {
+        Crc32cTables tables{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t crc = n;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+            }
+            tables.table[0][n] = crc;
+        }
+        for (uint32_t n = 0; n < 256; ++n) {
+            for (int k = 1; k < 8; ++k) {
+                const uint32_t previous = tables.table[k - 1][n];
+                tables.table[k][n] = (previous >> 8) ^ tables.table[0][previous & 0xFF];
+            }
+        }
+        return tables;
+    }
+
+    constexpr Crc32cTables CRC32C_TABLES = make_crc32c_tables();
+}
+
+/* ========================================================================== */
+/* CRC32C                                                                    */
+/* ========================================================================== */
+
+uint32_t crc32c_portable(uint32_t crc, const uint8_t* data, size_t size) noexcept
+{
+    const auto& t = CRC32C_TABLES.table;
+    crc = ~crc;
+
+    for (; size >= 8; size -= 8, data += 8) {
+        const uint64_t word = load_le64(data) ^ crc;
+        crc = t[7][word & 0xFF] ^ t[6][(word >> 8) & 0xFF] ^
+              t[5][(word >> 16) & 0xFF] ^ t[4][(word >> 24) & 0xFF] ^
+              t[3][(word >> 32) & 0xFF] ^ t[2][(word >> 40) & 0xFF] ^
+              t[1][(word >> 48) & 0xFF] ^ t[0][word >> 56];
+    }
+    for (; size != 0; --size, ++data) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+    }
+
+    return ~crc;
+}
+
+#if defined(CHECKSUM_SSE42_DISPATCH)
+namespace {
+    /**
+     * @brief Bytes per lane in the interleaved hardware loops
+     *
+     * The crc32 instruction has a latency of three cycles but a throughput of
+     * one per cycle, so three independent lanes keep it busy. The lanes are
+     * then merged by advancing the earlier CRCs over the later lanes' length.
+     */
+    constexpr size_t LONG_LANE = 8192;
+    constexpr size_t SHORT_LANE = 256;
+
+    /**
+     * @brief Lookup tables that advance a CRC over a fixed run of zero bytes
+     */
+    struct ZeroShift {
+        uint32_t table[4][256];
+    };
+
+    constexpr uint32_t gf2_matrix_times(const uint32_t* matrix, uint32_t vector) noexcept
+    {
+        uint32_t sum = 0;
+        for (; vector != 0; vector >>= 1, ++matrix) {
+            if (vector & 1) {
+                sum ^= *matrix;
+            }
+        }
+        return sum;
+    }
+
+    constexpr void gf2_matrix_square(uint32_t* square, const uint32_t* matrix) noexcept
+    {
+        for (int n = 0; n < 32; ++n) {
+            square[n] = gf2_matrix_times(matrix, matrix[n]);
+        }
+    }
+
+    constexpr ZeroShift make_zero_shift(size_t length) noexcept
+    {
+        // Operator for one zero bit, then square it up to one zero byte
+        uint32_t odd[32] = {};
+        uint32_t even[32] = {};
+        odd[0] = CRC32C_POLY;
+        for (int n = 1; n < 32; ++n) {
+            odd[n] = uint32_t{1} << (n - 1);
+        }
+        gf2_matrix_square(even, odd);  // 2 zero bits
+        gf2_matrix_square(odd, even);  // 4 zero bits
+        gf2_matrix_square(even, odd);  // 8 zero bits
+
+        // Raise the one-byte operator to the power length
+        uint32_t result[32] = {};
+        for (int n = 0; n < 32; ++n) {
+            result[n] = uint32_t{1} << n;
+        }
+        uint32_t* power = even;
+        uint32_t* spare = odd;
+        for (; length != 0; length >>= 1) {
+            if (length & 1) {
+                uint32_t product[32] = {};
+                for (int n = 0; n < 32; ++n) {
+                    product[n] = gf2_matrix_times(power, result[n]);
+                }
+                for (int n = 0; n < 32; ++n) {
+                    result[n] = product[n];
+                }
+            }
+            gf2_matrix_square(spare, power);
+            uint32_t* const swap = power;
+            power = spare;
+            spare = swap;
+        }
+
+        ZeroShift shift{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            shift.table[0][n] = gf2_matrix_times(result, n);
+            shift.table[1][n] = gf2_matrix_times(result, n << 8);
+            shift.table[2][n] = gf2_matrix_times(result, n << 16);
+            shift.table[3][n] = gf2_matrix_times(result, n << 24);
+        }
+        return shift;
+    }
+
+    constexpr ZeroShift LONG_SHIFT = make_zero_shift(LONG_LANE);
+    constexpr ZeroShift SHORT_SHIFT = make_zero_shift(SHORT_LANE);
+
+    inline uint32_t shift_crc(const ZeroShift& shift, uint32_t crc) noexcept
+    {
+        return shift.table[0][crc & 0xFF] ^ shift.table[1][(crc >> 8) & 0xFF] ^
+               shift.table[2][(crc >> 16) & 0xFF] ^ shift.table[3][crc >> 24];
+    }
+
+    template <size_t Lane>
+    __attribute__((target("sse4.2")))
+    inline uint64_t crc32c_lanes(uint64_t crc, const uint8_t*& data, size_t& size, const ZeroShift& shift) noexcept
+    {
+        while (size >= 3 * Lane) {
+            uint64_t crc1 = 0;
+            uint64_t crc2 = 0;
+            for (size_t offset = 0; offset < Lane; offset += 8) {
+                crc = _mm_crc32_u64(crc, load_le64(data + offset));
+                crc1 = _mm_crc32_u64(crc1, load_le64(data + Lane + offset));
+                crc2 = _mm_crc32_u64(crc2, load_le64(data + 2 * Lane + offset));
+            }
+            crc = shift_crc(shift, static_cast<uint32_t>(crc)) ^ crc1;
+            crc = shift_crc(shift, static_cast<uint32_t>(crc)) ^ crc2;
+            data += 3 * Lane;
+            size -= 3 * Lane;
+        }
+        return crc;
+    }
+
+    __attribute__((target("sse4.2")))
+    uint32_t crc32c_sse42(uint32_t crc, const uint8_t* data, size_t size) noexcept
+    {
+        uint64_t state = ~crc;
+        state = crc32c_lanes<LONG_LANE>(state, data, size, LONG_SHIFT);
+        state = crc32c_lanes<SHORT_LANE>(state, data, size, SHORT_SHIFT);
+        for (; size >= 8; size -= 8, data += 8) {
+            state = _mm_crc32_u64(state, load_le64(data));
+        }
+        uint32_t tail = static_cast<uint32_t>(state);
+        for (; size != 0; --size, ++data) {
+            tail = _mm_crc32_u8(tail, *data);
+        }
+        return ~tail;
+    }
+}
+#endif
+
+namespace {
+    using Crc32cFunction = uint32_t (*)(uint32_t, const uint8_t*, size_t) noexcept;
+
+    Crc32cFunction select_crc32c() noexcept
+    {
+#if defined(CHECKSUM_SSE42_DISPATCH)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.2")) {
+            return crc32c_sse42;
+        }
+#endif
+        return crc32c_portable;
+    }
+
+    Crc32cFunction crc32c_implementation() noexcept
+    {
+        static const Crc32cFunction implementation = select_crc32c();
+        return implementation;
+    }
+}
+
+uint32_t crc32c(uint32_t crc, const uint8_t* data, size_t size) noexcept
+{
+    return crc32c_implementation()(crc, data, size);
+}
+
+bool crc32c_accelerated() noexcept
+{
+    return crc32c_implementation() != &crc32c_portable;
+}
+
+/* ========================================================================== */
+/* xxHash64                                                                  */
+/* ========================================================================== */
+
+namespace {
+    constexpr uint64_t XXH_PRIME1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t XXH_PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    constexpr uint64_t XXH_PRIME3 = 0x165667B19E3779F9ULL;
+    constexpr uint64_t XXH_PRIME4 = 0x85EBCA77C2B2AE63ULL;
+    constexpr uint64_t XXH_PRIME5 = 0x27D4EB2F165667C5ULL;
+
+    inline uint64_t xxh_round(uint64_t accumulator, uint64_t input) noexcept
+    {
+        accumulator += input * XXH_PRIME2;
+        accumulator = std::rotl(accumulator, 31);
+        return accumulator * XXH_PRIME1;
+    }
+
+    inline uint64_t xxh_merge(uint64_t hash, uint64_t accumulator) noexcept
+    {
+        hash ^= xxh_round(0, accumulator);
+        return hash * XXH_PRIME1 + XXH_PRIME4;
+    }
+}
+
+uint64_t xxhash64(const uint8_t* data, size_t size, uint64_t seed) noexcept
+{
+    const uint8_t* const end = data + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        uint64_t v1 = seed + XXH_PRIME1 + XXH_PRIME2;
+        uint64_t v2 = seed + XXH_PRIME2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - XXH_PRIME1;
+        do {
+            v1 = xxh_round(v1, load_le64(data));
+            v2 = xxh_round(v2, load_le64(data + 8));
+            v3 = xxh_round(v3, load_le64(data + 16));
+            v4 = xxh_round(v4, load_le64(data + 24));
+            data += 32;
+        } while (end - data >= 32);
+
+        hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        hash = xxh_merge(hash, v1);
+        hash = xxh_merge(hash, v2);
+        hash = xxh_merge(hash, v3);
+        hash = xxh_merge(hash, v4);
+    } else {
+        hash = seed + XXH_PRIME5;
+    }
+
+    hash += static_cast<uint64_t>(size);
+
+    for (; end - data >= 8; data += 8) {
+        hash ^= xxh_round(0, load_le64(data));
+        hash = std::rotl(hash, 27) * XXH_PRIME1 + XXH_PRIME4;
+    }
+    if (end - data >= 4) {
+        hash ^= static_cast<uint64_t>(load_le32(data)) * XXH_PRIME1;
+        hash = std::rotl(hash, 23) * XXH_PRIME2 + XXH_PRIME3;
+        data += 4;
+    }
+    for (; data < end; ++data) {
+        hash ^= static_cast<uint64_t>(*data) * XXH_PRIME5;
+        hash = std::rotl(hash, 11) * XXH_PRIME1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+} // namespace checksum
+} // namespace dataproc
@@ -0,0 +1,49 @@
+/**
+ * @file checksum.h
+ * @brief Block checksums used by the stream module's integrity checking
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ *
+ * Two algorithms are provided. CRC32C (Castagnoli) runs on the SSE4.2
+ * crc32 instruction when the CPU has it, which makes it the cheaper choice
+ * there; a table driven version gives the same results everywhere else.
+ * xxHash64 is the portable choice for CPUs without a CRC instruction.
+ */
+
+#ifndef CHECKSUM_
+#define CHECKSUM_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dataproc {
+namespace checksum {
+
+/**
+ * @brief CRC32C of @p size bytes, continuing from @p crc
+ *
+ * Pass 0 to start a new checksum, or a previous result to extend it.
+ * Dispatches to the hardware implementation when available.
+ */
+uint32_t crc32c(uint32_t crc, const uint8_t* data, size_t size) noexcept;
+
+/**
+ * @brief Table driven CRC32C, identical in result to crc32c()
+ */
+uint32_t crc32c_portable(uint32_t crc, const uint8_t* data, size_t size) noexcept;
+
+/**
+ * @brief Whether crc32c() runs on a hardware CRC instruction
+ */
+bool crc32c_accelerated() noexcept;
+
+/**
+ * @brief xxHash64 of @p size bytes
+ */
+uint64_t xxhash64(const uint8_t* data, size_t size, uint64_t seed = 0) noexcept;
+
+} // namespace checksum
+} // namespace dataproc
+
+#endif /* CHECKSUM_ */
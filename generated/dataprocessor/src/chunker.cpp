@@ -0,0 +1,133 @@
+/**
+ * @file chunker.cpp
+ * @brief Implementation of the FastCDC content-defined chunker
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "chunker.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace dataproc {
+
+/* ========================================================================== */
+/* Private Helpers                                                           */
+/* ========================================================================== */
+
+namespace {
+    /**
+     * Gear table: 256 pseudo-random words from splitmix64 with a fixed seed.
+     * Changing it moves every content-defined boundary, so it is part of the
+     * chunking scheme even though decoders never need it.
+     */
+    constexpr std::array<uint64_t, 256> make_gear_table() noexcept
+    {
+        std::array<uint64_t, 256> table{};
+        uint64_t state = 0x6A09E667F3BCC908ULL;
+        for (uint64_t& entry : table) {
+            state += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            entry = z ^ (z >> 31);
+        }
+        return table;
+    }
+
+    constexpr std::array<uint64_t, 256> GEAR = make_gear_table();
+
+    /* GEAR shifted left once, for rolling two bytes per step */
+    constexpr std::array<uint64_t, 256> GEAR_SHIFTED = [] {
+        std::array<uint64_t, 256> table{};
+        for (size_t i = 0; i < table.size(); ++i) {
+            table[i] = GEAR[i] << 1;
+        }
+        return table;
+    }();
+
+    /**
+     * Mask of @p bits ones in bits 62 and down. Bit j of the Gear hash depends
+     * on the last j + 1 bytes, so high bits see a 64-byte window; bit 63 is
+     * left clear so the mask can be shifted for the two-byte roll.
+     */
+    constexpr uint64_t high_mask(unsigned bits) noexcept
+    {
+        return ((uint64_t{1} << bits) - 1) << (63 - bits);
+    }
+
+    /**
+     * Scan [pos, end) for a hash match, rolling two bytes per step.
+     *
+     * The Gear recurrence h = (h << 1) + G[b] is a serial dependency, so the
+     * loop is bound by its latency rather than by loads. Folding two bytes as
+     * h = (h << 2) + (G[b0] << 1) + G[b1] halves the chain; the hash after b0
+     * is checked as (h << 1) against (mask << 1), which is equivalent because
+     * the mask leaves bit 63 clear.
+     *
+     * @return Length of the chunk ending at the match, or 0 when none
+     */
+    inline size_t scan(const uint8_t* data, size_t pos, size_t end, uint64_t mask, uint64_t& hash) noexcept
+    {
+        const uint64_t mask_shifted = mask << 1;
+        uint64_t h = hash;
+        for (; pos + 2 <= end; pos += 2) {
+            const uint64_t half = (h << 2) + GEAR_SHIFTED[data[pos]];
+            if ((half & mask_shifted) == 0) [[unlikely]] {
+                return pos + 1;
+            }
+            h = half + GEAR[data[pos + 1]];
+            if ((h & mask) == 0) [[unlikely]] {
+                return pos + 2;
+            }
+        }
+        if (pos < end) {
+            h = (h << 1) + GEAR[data[pos]];
+            if ((h & mask) == 0) {
+                return pos + 1;
+            }
+        }
+        hash = h;
+        return 0;
+    }
+}
+
+/* ========================================================================== */
+/* ContentChunker Implementation                                              */
+/* ========================================================================== */
+
+ContentChunker::ContentChunker(size_t max_size) noexcept
+    : min_size_(max_size / 8)
+    , average_size_(max_size / 2)
+    , max_size_(max_size)
+{
+    /* Normalization level 2: two more mask bits below the average, two fewer above */
+    const unsigned bits = static_cast<unsigned>(std::bit_width(average_size_) - 1);
+    strict_mask_ = high_mask(std::min(bits + 2, 62u));
+    loose_mask_ = high_mask(std::max(bits, 3u) - 2);
+}
+
+size_t ContentChunker::find_cut(std::span<const uint8_t> data) const noexcept
+{
+    const size_t size = data.size();
+    if (size <= min_size_) {
+        return 0;
+    }
+
+    const size_t limit = std::min(size, max_size_);
+    const size_t normal = std::min(limit, average_size_);
+    uint64_t hash = 0;
+    size_t cut = scan(data.data(), min_size_, normal, strict_mask_, hash);
+    if (cut == 0) {
+        cut = scan(data.data(), normal, limit, loose_mask_, hash);
+    }
+    if (cut != 0) {
+        return cut;
+    }
+    return size >= max_size_ ? max_size_ : 0;
+}
+
+} // namespace dataproc
@@ -0,0 +1,74 @@
+/**
+ * @file chunker.h
+ * @brief Content-defined chunking (FastCDC) for ChunkingMode::ContentDefined
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ *
+ * Block boundaries are placed where a Gear rolling hash of the data matches
+ * a mask, so an insertion or deletion only moves the boundaries next to it
+ * and the blocks after it line up again (Xia et al., FastCDC, 2016/2020).
+ */
+
+#ifndef CHUNKER_
+#define CHUNKER_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace dataproc {
+
+/**
+ * @brief Smallest buffer_size accepted for content-defined chunking
+ */
+constexpr size_t MIN_CONTENT_CHUNK_BUFFER = 256;
+
+/**
+ * @brief FastCDC chunker bounded by a maximum chunk size
+ *
+ * Chunks are at least max_size / 8 bytes (the hash is not examined before
+ * that) and at most max_size bytes, averaging about max_size / 2 bytes.
+ * Normalized chunking uses a stricter mask before the average size and a
+ * looser one after it, which narrows the size distribution. The hash restarts
+ * at every chunk, so a cut depends only on the bytes of its own chunk.
+ */
+class ContentChunker {
+public:
+    /**
+     * @param max_size Largest chunk, at least MIN_CONTENT_CHUNK_BUFFER
+     */
+    explicit ContentChunker(size_t max_size) noexcept;
+
+    size_t min_size() const noexcept { return min_size_; }
+    size_t average_size() const noexcept { return average_size_; }
+    size_t max_size() const noexcept { return max_size_; }
+
+    /**
+     * @brief Length of the chunk that starts at the beginning of @p data
+     *
+     * @return The chunk length, or 0 when @p data ends before a cut could be
+     *         decided (fewer than max_size bytes and no hash match), in which
+     *         case more data may still move the cut
+     */
+    size_t find_cut(std::span<const uint8_t> data) const noexcept;
+
+    /**
+     * @brief Like find_cut(), treating the end of @p data as the end of input
+     */
+    size_t next_chunk(std::span<const uint8_t> data) const noexcept {
+        const size_t cut = find_cut(data);
+        return cut != 0 ? cut : data.size();
+    }
+
+private:
+    size_t min_size_;
+    size_t average_size_;
+    size_t max_size_;
+    uint64_t strict_mask_;  ///< Used below the average size
+    uint64_t loose_mask_;  ///< Used from the average size on
+};
+
+} // namespace dataproc
+
+#endif /* CHUNKER_ */
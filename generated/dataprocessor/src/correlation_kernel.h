@@ -0,0 +1,76 @@
+/**
+ * @file correlation_kernel.h
+ * @brief Blocked Z^T Z product behind Analyzer::compute_correlation_matrix
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ *
+ * Once every variable is standardized to zero mean and unit norm, the
+ * correlation matrix is the Gram matrix Z^T Z of the standardized columns,
+ * a symmetric rank-k update (SYRK). The product is split into square tiles
+ * of TILE_COLUMNS columns so tiles can run on different threads, and only
+ * tiles on or above the diagonal are computed. Within a tile, a register
+ * blocked micro-kernel forms several column dot products at once over
+ * SAMPLE_BLOCK rows, so its operands stay in cache. AVX-512 and AVX2
+ * micro-kernels are chosen at first use; a portable one gives the same
+ * results up to rounding everywhere else.
+ */
+
+#ifndef CORRELATION_KERNEL_
+#define CORRELATION_KERNEL_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dataproc {
+namespace correlation {
+
+/**
+ * @brief Columns per tile; column counts are padded to a multiple of this
+ *
+ * Divisible by every micro-kernel's block shape.
+ */
+constexpr size_t TILE_COLUMNS = 48;
+
+/**
+ * @brief Row count multiple (and column alignment, in doubles) the kernels expect
+ */
+constexpr size_t COLUMN_ALIGNMENT = 8;
+
+/**
+ * @brief Rows a micro-kernel sweeps before writing its sums back
+ */
+constexpr size_t SAMPLE_BLOCK = 512;
+
+/**
+ * @brief Instruction set the micro-kernel runs on
+ */
+enum class Kernel : uint8_t {
+    Portable = 0,
+    Avx2 = 1,
+    Avx512 = 2
+};
+
+/**
+ * @brief Widest kernel this CPU runs; every narrower one also runs
+ */
+Kernel best_kernel() noexcept;
+
+/**
+ * @brief Dot products between two tiles of columns
+ *
+ * Column c of a tile starts at @p a + c * @p stride (resp. @p b); columns
+ * hold @p rows values, a multiple of COLUMN_ALIGNMENT, and start on a
+ * 64-byte boundary.
+ *
+ * @param diagonal Whether @p a and @p b are the same tile; then only the
+ *        upper triangle (j >= i) of @p out is computed
+ * @param out TILE_COLUMNS x TILE_COLUMNS row-major; out[i][j] = a_i . b_j
+ */
+void tile_product(Kernel kernel, const double* a, const double* b, size_t stride, size_t rows,
+                  bool diagonal, double* out) noexcept;
+
+} // namespace correlation
+} // namespace dataproc
+
+#endif /* CORRELATION_KERNEL_ */
@@ -0,0 +1,56 @@
+/**
+ * @file dedup_cache.cpp
+ * @brief Implementation of the block deduplication cache
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "dedup_cache.h"
+#include "checksum.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+namespace dataproc {
+
+/* ========================================================================== */
+/* DedupCache Implementation                                                  */
+/* ========================================================================== */
+
+DedupCache::DedupCache(size_t entries)
+    : entries_(std::make_unique<Entry[]>(std::bit_ceil(std::max<size_t>(entries, 1))))
+    , mask_(std::bit_ceil(std::max<size_t>(entries, 1)) - 1)
+{
+}
+
+DedupCache::~DedupCache() = default;
+
+void DedupCache::begin() noexcept
+{
+    // Entries of earlier scopes are ignored rather than cleared
+    ++scope_;
+}
+
+uint32_t DedupCache::find_or_insert(std::span<const uint8_t> data, size_t index) noexcept
+{
+    if (data.size() < MIN_DEDUP_BLOCK_SIZE) {
+        return 0;
+    }
+
+    const uint64_t hash = checksum::xxhash64(data.data(), data.size());
+    Entry& entry = entries_[hash & mask_];
+    if (entry.scope == scope_ && entry.hash == hash && entry.size == data.size() &&
+        index - entry.index <= std::numeric_limits<uint32_t>::max() &&
+        std::memcmp(entry.data, data.data(), data.size()) == 0) {
+        // Keep pointing at the first copy, so references never chain
+        return static_cast<uint32_t>(index - entry.index);
+    }
+
+    entry = Entry{hash, data.data(), data.size(), index, scope_};
+    return 0;
+}
+
+} // namespace dataproc
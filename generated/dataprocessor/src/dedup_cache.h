@@ -0,0 +1,84 @@
+/**
+ * @file dedup_cache.h
+ * @brief Bounded index of recent blocks for StreamConfig::dedup_cache_entries
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#ifndef DEDUP_CACHE_
+#define DEDUP_CACHE_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace dataproc {
+
+/**
+ * @brief Smallest block worth replacing with a back-reference
+ *
+ * Below this a reference block is not much smaller than the data itself.
+ */
+constexpr size_t MIN_DEDUP_BLOCK_SIZE = 64;
+
+/**
+ * @brief Largest StreamConfig::dedup_cache_entries accepted
+ */
+constexpr size_t MAX_DEDUP_CACHE_ENTRIES = size_t{1} << 24;
+
+/**
+ * @brief Direct-mapped hash -> block index table over one scope of blocks
+ *
+ * Each slot remembers the newest block whose 64-bit content hash maps to
+ * it, so the table never grows and a lookup is one probe. A hit is only
+ * reported after comparing the bytes, so hash collisions cannot alias two
+ * different blocks. Entries point into the caller's input and are only
+ * valid until the next begin(), which is O(1).
+ */
+class DedupCache {
+public:
+    /**
+     * @param entries Slots to keep, rounded up to a power of two
+     */
+    explicit DedupCache(size_t entries);
+    ~DedupCache();
+
+    DedupCache(const DedupCache&) = delete;
+    DedupCache& operator=(const DedupCache&) = delete;
+
+    size_t capacity() const noexcept { return mask_ + 1; }
+
+    /**
+     * @brief Forget every block, starting a new scope
+     */
+    void begin() noexcept;
+
+    /**
+     * @brief Look @p data up, then remember it as block @p index of the scope
+     *
+     * @param data Block contents, which must stay valid until begin()
+     * @param index Position of the block in the scope, increasing call by call
+     * @return Blocks back to an identical earlier block, or 0 when there is none
+     *         (or the block is smaller than MIN_DEDUP_BLOCK_SIZE)
+     */
+    uint32_t find_or_insert(std::span<const uint8_t> data, size_t index) noexcept;
+
+private:
+    struct Entry {
+        uint64_t hash;
+        const uint8_t* data;
+        size_t size;
+        size_t index;
+        uint64_t scope;  ///< Entry is live only when this matches scope_
+    };
+
+    std::unique_ptr<Entry[]> entries_;
+    size_t mask_;
+    uint64_t scope_ = 1;
+};
+
+} // namespace dataproc
+
+#endif /* DEDUP_CACHE_ */
@@ -0,0 +1,304 @@
+/**
+ * @file lz4_codec.cpp
+ * @brief Implementation of the in-tree LZ4 block codec
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "lz4_codec.h"
+
+#include <cstddef>
+#include <cstring>
+
+namespace dataproc {
+namespace lz4 {
+
+/* ========================================================================== */
+/* Private Constants and Helpers                                             */
+/* ========================================================================== */
+
+namespace {
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t LAST_LITERALS = 5;   ///< The last 5 bytes are always literals
+    constexpr size_t MF_LIMIT = 12;       ///< The last match starts at least 12 bytes before the end
+    constexpr size_t MAX_DISTANCE = 65535;
+    constexpr unsigned SKIP_TRIGGER = 6;  ///< Speed up the search after 2^6 misses
+    constexpr unsigned RUN_MASK = 15;
+    constexpr unsigned ML_MASK = 15;
+    constexpr std::ptrdiff_t FAST_MARGIN = 32;  ///< Slack needed by the decoder's fixed-size copies
+
+    inline uint32_t read32(const uint8_t* p) noexcept
+    {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint64_t read64(const uint8_t* p) noexcept
+    {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint32_t hash_sequence(uint32_t sequence) noexcept
+    {
+        return (sequence * 2654435761u) >> (32 - HASH_LOG);
+    }
+
+    /**
+     * @brief Number of leading equal bytes given a non-zero XOR of two words
+     */
+    inline size_t equal_prefix_bytes(uint64_t diff) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return static_cast<size_t>(__builtin_clzll(diff)) >> 3;
+#else
+        return static_cast<size_t>(__builtin_ctzll(diff)) >> 3;
+#endif
+#else
+        size_t count = 0;
+        while ((diff & 0xFF) == 0) {
+            diff >>= 8;
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    /**
+     * @brief Length of the common prefix of @p ip and @p match, stopping at @p limit
+     */
+    inline size_t count_match(const uint8_t* ip, const uint8_t* match, const uint8_t* limit) noexcept
+    {
+        const uint8_t* const start = ip;
+        while (limit - ip >= 8) {
+            const uint64_t diff = read64(ip) ^ read64(match);
+            if (diff != 0) {
+                return static_cast<size_t>(ip - start) + equal_prefix_bytes(diff);
+            }
+            ip += 8;
+            match += 8;
+        }
+        while (ip < limit && *ip == *match) {
+            ++ip;
+            ++match;
+        }
+        return static_cast<size_t>(ip - start);
+    }
+
+    inline uint8_t* write_length(uint8_t* op, size_t length) noexcept
+    {
+        for (; length >= 255; length -= 255) {
+            *op++ = 255;
+        }
+        *op++ = static_cast<uint8_t>(length);
+        return op;
+    }
+
+    inline uint8_t* write_literals(uint8_t* op, const uint8_t* literals, size_t length, uint8_t*& token) noexcept
+    {
+        token = op++;
+        if (length >= RUN_MASK) {
+            *token = static_cast<uint8_t>(RUN_MASK << 4);
+            op = write_length(op, length - RUN_MASK);
+        } else {
+            *token = static_cast<uint8_t>(length << 4);
+        }
+        if (length != 0) {
+            std::memcpy(op, literals, length);
+        }
+        return op + length;
+    }
+
+    inline bool read_length(const uint8_t*& ip, const uint8_t* iend, size_t& length) noexcept
+    {
+        unsigned byte;
+        do {
+            if (ip >= iend) {
+                return false;
+            }
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+}
+
+/* ========================================================================== */
+/* Compression                                                               */
+/* ========================================================================== */
+
+size_t compress(CompressState& state, const uint8_t* src, size_t src_size, uint8_t* dst) noexcept
+{
+    uint8_t* op = dst;
+    uint8_t* token = nullptr;
+    const uint8_t* anchor = src;
+    const uint8_t* const iend = src + src_size;
+
+    if (src_size > MF_LIMIT) {
+        const uint8_t* const mflimit = iend - MF_LIMIT;
+        const uint8_t* const match_limit = iend - LAST_LITERALS;
+        uint32_t* const table = state.table;
+        const uint8_t* ip = src;
+
+        // Positions are stored relative to a base that moves past every
+        // block, so entries left by earlier calls fall below it and are
+        // ignored without clearing the table. Clear only when it would wrap.
+        if (state.base == 0 || state.base > UINT32_MAX - src_size - 1) {
+            std::memset(table, 0, sizeof(state.table));
+            state.base = 1;
+        }
+        const uint32_t base = state.base;
+        state.base = static_cast<uint32_t>(base + src_size + 1);
+
+        for (;;) {
+            const uint8_t* match = nullptr;
+            unsigned attempts = 1u << SKIP_TRIGGER;
+            while (ip <= mflimit) {
+                const uint32_t position = base + static_cast<uint32_t>(ip - src);
+                const uint32_t hash = hash_sequence(read32(ip));
+                const uint32_t candidate = table[hash];
+                table[hash] = position;
+                if (candidate >= base && candidate < position && position - candidate <= MAX_DISTANCE &&
+                    read32(src + (candidate - base)) == read32(ip)) {
+                    match = src + (candidate - base);
+                    break;
+                }
+                ip += attempts++ >> SKIP_TRIGGER;
+            }
+            if (match == nullptr) {
+                break;
+            }
+
+            while (ip > anchor && match > src && ip[-1] == match[-1]) {
+                --ip;
+                --match;
+            }
+
+            const size_t match_length =
+                MIN_MATCH + count_match(ip + MIN_MATCH, match + MIN_MATCH, match_limit);
+
+            op = write_literals(op, anchor, static_cast<size_t>(ip - anchor), token);
+
+            const size_t offset = static_cast<size_t>(ip - match);
+            *op++ = static_cast<uint8_t>(offset);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+
+            const size_t extra = match_length - MIN_MATCH;
+            if (extra >= ML_MASK) {
+                *token = static_cast<uint8_t>(*token | ML_MASK);
+                op = write_length(op, extra - ML_MASK);
+            } else {
+                *token = static_cast<uint8_t>(*token | extra);
+            }
+
+            ip += match_length;
+            anchor = ip;
+            if (ip > mflimit) {
+                break;
+            }
+            // Index a position inside the match to improve the next search
+            table[hash_sequence(read32(ip - 2))] = base + static_cast<uint32_t>(ip - 2 - src);
+        }
+    }
+
+    op = write_literals(op, anchor, static_cast<size_t>(iend - anchor), token);
+    return static_cast<size_t>(op - dst);
+}
+
+/* ========================================================================== */
+/* Decompression                                                             */
+/* ========================================================================== */
+
+bool decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) noexcept
+{
+    const uint8_t* ip = src;
+    const uint8_t* const iend = src + src_size;
+    uint8_t* op = dst;
+    uint8_t* const oend = dst + dst_size;
+
+    for (;;) {
+        if (ip >= iend) {
+            return false;
+        }
+        const unsigned token = *ip++;
+
+        size_t length = token >> 4;
+        if (length != RUN_MASK && iend - ip >= FAST_MARGIN && oend - op >= FAST_MARGIN) {
+            // Short literal run with room on both sides: one fixed-size copy,
+            // the excess is overwritten by what follows
+            std::memcpy(op, ip, 16);
+            ip += length;
+            op += length;
+        } else {
+            if (length == RUN_MASK && !read_length(ip, iend, length)) {
+                return false;
+            }
+            if (static_cast<size_t>(iend - ip) < length || static_cast<size_t>(oend - op) < length) {
+                return false;
+            }
+            if (length != 0) {
+                std::memcpy(op, ip, length);
+            }
+            ip += length;
+            op += length;
+
+            if (ip == iend) {
+                break;  // The last sequence carries literals only
+            }
+            if (iend - ip < 2) {
+                return false;
+            }
+        }
+
+        const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+            return false;
+        }
+        const uint8_t* match = op - offset;
+
+        length = token & ML_MASK;
+        if (length != ML_MASK && offset >= 8 && oend - op >= 18) {
+            // Matches of at most 18 bytes: three non-overlapping copies
+            std::memcpy(op, match, 8);
+            std::memcpy(op + 8, match + 8, 8);
+            std::memcpy(op + 16, match + 16, 2);
+            op += length + MIN_MATCH;
+            continue;
+        }
+
+        if (length == ML_MASK && !read_length(ip, iend, length)) {
+            return false;
+        }
+        length += MIN_MATCH;
+        if (static_cast<size_t>(oend - op) < length) {
+            return false;
+        }
+
+        uint8_t* const match_end = op + length;
+        if (offset >= 8 && static_cast<size_t>(oend - op) >= length + 8) {
+            // Non-overlapping 8-byte steps; may write up to 7 bytes past the match
+            do {
+                std::memcpy(op, match, 8);
+                op += 8;
+                match += 8;
+            } while (op < match_end);
+        } else if (offset == 1) {
+            std::memset(op, *match, length);
+        } else {
+            for (; op < match_end; ++op, ++match) {
+                *op = *match;
+            }
+        }
+        op = match_end;
+    }
+
+    return op == oend;
+}
+
+} // namespace lz4
+} // namespace dataproc
@@ -0,0 +1,77 @@
+/**
+ * @file lz4_codec.h
+ * @brief In-tree LZ4 block format compressor and decompressor
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ *
+ * Produces and consumes raw LZ4 blocks as described in the LZ4 block format
+ * specification, so the output interoperates with LZ4_decompress_safe() and
+ * the input may come from LZ4_compress_default(). Frames, dictionaries and
+ * the high-compression variant are intentionally not supported.
+ */
+
+#ifndef LZ4_CODEC_
+#define LZ4_CODEC_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dataproc {
+namespace lz4 {
+
+/**
+ * @brief Number of bits used to index the match finder's hash table
+ */
+constexpr unsigned HASH_LOG = 12;
+
+/**
+ * @brief Reusable compressor state
+ *
+ * Holds the match finder's hash table (16 KiB). Keep one per thread and
+ * reuse it across blocks; it does not need to be cleared between calls.
+ * Every call ignores what earlier calls left behind, so the output for a
+ * block does not depend on which state compressed it.
+ */
+struct CompressState {
+    uint32_t table[1u << HASH_LOG];
+    uint32_t base = 0;  ///< Table value of position 0 of the next block
+};
+
+/**
+ * @brief Worst-case compressed size for @p input_size bytes
+ */
+constexpr size_t compress_bound(size_t input_size) noexcept
+{
+    return input_size + input_size / 255 + 16;
+}
+
+/**
+ * @brief Compress one block
+ *
+ * @param state Scratch state owned by the calling thread
+ * @param src Input bytes
+ * @param src_size Number of input bytes (must fit in 31 bits)
+ * @param dst Output buffer of at least compress_bound(src_size) bytes
+ * @return size_t Number of bytes written to @p dst
+ */
+size_t compress(CompressState& state, const uint8_t* src, size_t src_size, uint8_t* dst) noexcept;
+
+/**
+ * @brief Decompress one block whose decoded size is known
+ *
+ * Every read and write is bounds checked, so malformed input is rejected
+ * rather than overrunning either buffer.
+ *
+ * @param src Compressed bytes
+ * @param src_size Number of compressed bytes
+ * @param dst Output buffer
+ * @param dst_size Exact decoded size of the block
+ * @return bool True if the block decoded to exactly @p dst_size bytes
+ */
+bool decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) noexcept;
+
+} // namespace lz4
+} // namespace dataproc
+
+#endif /* LZ4_CODEC_ */
@@ -0,0 +1,147 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Implementation of the read-only file mapping
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "mapped_file.h"
+#include "stream.h"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <vector>
+#endif
+
+namespace dataproc {
+
+namespace {
+    [[noreturn]] void throw_file_error(const std::string& action, const std::string& path, int error)
+    {
+        throw StreamRuntimeException("cannot " + action + " " + path + ": " + std::strerror(error));
+    }
+}
+
+#if defined(MAPPED_FILE_POSIX)
+
+struct MappedFile::Impl {
+    int fd = -1;
+    uint8_t* base = nullptr;
+    size_t mapped_size = 0;
+    size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t released = 0;  ///< Bytes at the start of the mapping already dropped
+
+    ~Impl() {
+        if (base != nullptr) {
+            ::munmap(base, mapped_size);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+};
+
+MappedFile::MappedFile(const std::string& path)
+    : pimpl_(std::make_unique<Impl>())
+{
+    pimpl_->fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (pimpl_->fd < 0) {
+        throw_file_error("open", path, errno);
+    }
+
+    struct stat info {};
+    if (::fstat(pimpl_->fd, &info) != 0) {
+        throw_file_error("stat", path, errno);
+    }
+    if (!S_ISREG(info.st_mode)) {
+        throw StreamRuntimeException("cannot map " + path + ": not a regular file");
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ == 0) {
+        return;  // Nothing to map; mmap() rejects empty ranges
+    }
+
+    void* const mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, pimpl_->fd, 0);
+    if (mapping == MAP_FAILED) {
+        throw_file_error("map", path, errno);
+    }
+    pimpl_->base = static_cast<uint8_t*>(mapping);
+    pimpl_->mapped_size = size_;
+
+    // Hints only: failures leave default paging, which is still correct
+    ::madvise(mapping, size_, MADV_SEQUENTIAL);
+#if defined(MADV_HUGEPAGE)
+    ::madvise(mapping, size_, MADV_HUGEPAGE);
+#endif
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(pimpl_->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+MappedFile::~MappedFile() = default;
+
+std::span<const uint8_t> MappedFile::window(size_t offset, size_t length)
+{
+    return {pimpl_->base + offset, length};
+}
+
+void MappedFile::release_before(size_t offset) noexcept
+{
+    const size_t aligned = offset - offset % pimpl_->page_size;
+    if (aligned > pimpl_->released) {
+        // Drops the pages from this process; clean file pages stay cached
+        ::madvise(pimpl_->base + pimpl_->released, aligned - pimpl_->released, MADV_DONTNEED);
+        pimpl_->released = aligned;
+    }
+}
+
+#else
+
+struct MappedFile::Impl {
+    std::ifstream file;
+    std::vector<uint8_t> buffer;
+    std::string path;
+};
+
+MappedFile::MappedFile(const std::string& path)
+    : pimpl_(std::make_unique<Impl>())
+{
+    pimpl_->path = path;
+    pimpl_->file.open(path, std::ios::binary | std::ios::ate);
+    if (!pimpl_->file) {
+        throw_file_error("open", path, errno);
+    }
+    size_ = static_cast<size_t>(pimpl_->file.tellg());
+    pimpl_->file.seekg(0);
+}
+
+MappedFile::~MappedFile() = default;
+
+std::span<const uint8_t> MappedFile::window(size_t offset, size_t length)
+{
+    pimpl_->buffer.resize(length);
+    pimpl_->file.seekg(static_cast<std::streamoff>(offset));
+    pimpl_->file.read(reinterpret_cast<char*>(pimpl_->buffer.data()), static_cast<std::streamsize>(length));
+    if (!pimpl_->file) {
+        throw_file_error("read", pimpl_->path, errno);
+    }
+    return pimpl_->buffer;
+}
+
+void MappedFile::release_before(size_t) noexcept
+{
+}
+
+#endif
+
+} // namespace dataproc
@@ -0,0 +1,72 @@
+/**
+ * @file mapped_file.h
+ * @brief Read-only file mapping used for file input in the stream module
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ *
+ * On POSIX systems the file is mapped with mmap() and advised for sequential
+ * access; pages are dropped again as the reader moves past them, so resident
+ * memory stays around one window whatever the file size. Elsewhere the file
+ * is read window by window into a reusable buffer.
+ */
+
+#ifndef MAPPED_FILE_
+#define MAPPED_FILE_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace dataproc {
+
+/**
+ * @brief A file opened for a single sequential pass
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Open and map @p path
+     * @throws StreamRuntimeException if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+
+    /**
+     * @brief Unmap and close the file
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief File size in bytes
+     */
+    size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Make @p length bytes from @p offset readable
+     *
+     * Windows must be requested in increasing order. The returned span stays
+     * valid until the next call.
+     *
+     * @throws StreamRuntimeException on a read error
+     */
+    std::span<const uint8_t> window(size_t offset, size_t length);
+
+    /**
+     * @brief Tell the system the reader is done with everything before @p offset
+     */
+    void release_before(size_t offset) noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl_;
+    size_t size_ = 0;
+};
+
+} // namespace dataproc
+
+#endif /* MAPPED_FILE_ */
@@ -0,0 +1,288 @@
+/**
+ * @file ring_buffer.h
+ * @brief Bounded lock-free ring buffers for handing work between threads
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ *
+ * SpscRing links exactly one producer to one consumer, as between pipeline
+ * stages; MpmcRing (Dmitry Vyukov's bounded queue) serves any number of
+ * each, as for free lists and work queues. Neither allocates after
+ * construction, and both only block in the explicit waiting calls.
+ */
+
+#ifndef RING_BUFFER_
+#define RING_BUFFER_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace dataproc {
+
+/**
+ * @brief Assumed cache line size, used to keep producer and consumer state apart
+ */
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Bounded single-producer single-consumer queue
+ *
+ * Each side owns its index on a separate cache line and keeps a private copy
+ * of the other side's index, so it only touches the shared line when the
+ * copy says the ring looks full (or empty). The blocking calls sleep on the
+ * other side's index with std::atomic wait/notify instead of a mutex.
+ *
+ * @tparam T Default-constructible, move-assignable element type
+ */
+template<typename T>
+class SpscRing {
+public:
+    /**
+     * @brief Create a ring holding at least @p capacity elements
+     */
+    explicit SpscRing(size_t capacity)
+        : slots_(std::bit_ceil(std::max<size_t>(capacity, 2))),
+          mask_(slots_.size() - 1)
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Number of elements the ring holds
+     */
+    size_t capacity() const noexcept { return slots_.size(); }
+
+    /**
+     * @brief Append @p value unless the ring is full (producer only)
+     * @return true if @p value was moved into the ring
+     */
+    bool try_push(T& value) {
+        const size_t tail = producer_.tail.load(std::memory_order_relaxed);
+        if (tail - producer_.cached_head > mask_) {
+            producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+            if (tail - producer_.cached_head > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = std::move(value);
+        producer_.tail.store(tail + 1, std::memory_order_release);
+        producer_.tail.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Append @p value, waiting while the ring is full (producer only)
+     */
+    void push(T value) {
+        while (!try_push(value)) {
+            consumer_.head.wait(producer_.cached_head, std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief Take the oldest element unless the ring is empty (consumer only)
+     * @return true if an element was moved into @p value
+     */
+    bool try_pop(T& value) {
+        const size_t head = consumer_.head.load(std::memory_order_relaxed);
+        if (head == consumer_.cached_tail) {
+            consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+            if (head == consumer_.cached_tail) {
+                return false;
+            }
+        }
+        value = std::move(slots_[head & mask_]);
+        consumer_.head.store(head + 1, std::memory_order_release);
+        consumer_.head.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest element, waiting while the ring is empty (consumer only)
+     */
+    T pop() {
+        T value;
+        while (!try_pop(value)) {
+            producer_.tail.wait(consumer_.cached_tail, std::memory_order_acquire);
+        }
+        return value;
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Consumer {
+        std::atomic<size_t> head{0};
+        size_t cached_tail = 0;  ///< Last tail the consumer saw
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Producer {
+        std::atomic<size_t> tail{0};
+        size_t cached_head = 0;  ///< Last head the producer saw
+    };
+
+    Consumer consumer_;
+    Producer producer_;
+    std::vector<T> slots_;
+    size_t mask_;
+};
+
+/**
+ * @brief Bounded multi-producer multi-consumer queue
+ *
+ * Every cell carries a sequence number saying whether it is ready to be
+ * written or read for a given lap of the ring, so producers and consumers
+ * claim positions with one compare-and-swap and never wait on each other
+ * except when the ring is full or empty. Cells and both positions sit on
+ * their own cache lines. The blocking calls sleep on event counters with
+ * std::atomic wait/notify.
+ *
+ * @tparam T Default-constructible, move-assignable element type
+ */
+template<typename T>
+class MpmcRing {
+public:
+    /**
+     * @brief Create a ring holding at least @p capacity elements
+     */
+    explicit MpmcRing(size_t capacity)
+        : cells_(std::bit_ceil(std::max<size_t>(capacity, 2))),
+          mask_(cells_.size() - 1)
+    {
+        for (size_t i = 0; i < cells_.size(); ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    /**
+     * @brief Number of elements the ring holds
+     */
+    size_t capacity() const noexcept { return cells_.size(); }
+
+    /**
+     * @brief Number of elements queued; exact only while no call is in progress
+     */
+    size_t size() const noexcept {
+        const size_t head = dequeue_.position.load(std::memory_order_acquire);
+        const size_t tail = enqueue_.position.load(std::memory_order_acquire);
+        return tail > head ? std::min(tail - head, cells_.size()) : 0;
+    }
+
+    /**
+     * @brief Append @p value unless the ring is full
+     * @return true if @p value was moved into the ring
+     */
+    bool try_push(T& value) {
+        size_t position = enqueue_.position.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto lap = static_cast<std::ptrdiff_t>(sequence - position);
+            if (lap == 0) {
+                if (enqueue_.position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    signal(pushes_);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false;  // The cell still holds last lap's element
+            } else {
+                position = enqueue_.position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Append @p value, waiting while the ring is full
+     */
+    void push(T value) {
+        for (;;) {
+            const uint32_t seen = pops_.count.load(std::memory_order_acquire);
+            if (try_push(value)) {
+                return;
+            }
+            pops_.count.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief Take the oldest element unless the ring is empty
+     * @return true if an element was moved into @p value
+     */
+    bool try_pop(T& value) {
+        size_t position = dequeue_.position.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto lap = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+            if (lap == 0) {
+                if (dequeue_.position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + cells_.size(), std::memory_order_release);
+                    signal(pops_);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false;  // Nothing written to this cell yet
+            } else {
+                position = dequeue_.position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Take the oldest element, waiting while the ring is empty
+     */
+    T pop() {
+        T value;
+        for (;;) {
+            const uint32_t seen = pushes_.count.load(std::memory_order_acquire);
+            if (try_pop(value)) {
+                return value;
+            }
+            pushes_.count.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Position {
+        std::atomic<size_t> position{0};
+    };
+
+    /**
+     * @brief Count of completed pushes or pops, for the blocking calls to wait on
+     */
+    struct alignas(CACHE_LINE_SIZE) Events {
+        std::atomic<uint32_t> count{0};
+    };
+
+    static void signal(Events& events) noexcept {
+        events.count.fetch_add(1, std::memory_order_release);
+        events.count.notify_one();
+    }
+
+    Position enqueue_;
+    Position dequeue_;
+    Events pushes_;
+    Events pops_;
+    std::vector<Cell> cells_;
+    size_t mask_;
+};
+
+} // namespace dataproc
+
+#endif /* RING_BUFFER_ */
@@ -7,7 +7,23 @@
  */
 
 #include "stream.h"
+#include "async_writer.h"
+#include "block_codec.h"
+#include "buffer_pool.h"
+#include "checksum.h"
+#include "chunker.h"
+#include "dedup_cache.h"
+#include "mapped_file.h"
+#include "stream_executor.h"
+#include "worker_pool.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <utility>
 #include <iostream>
 #include <sstream>
 #include <mutex>
@@ -25,6 +41,206 @@ namespace {
     std::atomic<bool> g_initialized{false};
     std::atomic<size_t> g_reference_count{0};
     std::mutex g_mutex;
+
+    /**
+     * @brief Bytes of input handed to a worker at a time
+     *
+     * Large enough that claiming a task is negligible next to the work in it,
+     * small enough that a few slow tasks cannot hold up the whole call.
+     */
+    constexpr size_t PARALLEL_TASK_BYTES = 256 * 1024;
+
+    /**
+     * @brief Bytes of input processed per window when output goes to a sink
+     *
+     * Big enough to keep every worker busy, small enough that the resident
+     * part of a mapped file and the per-window output stay modest.
+     */
+    constexpr size_t SINK_WINDOW_BYTES = 16 * 1024 * 1024;
+
+    /**
+     * @brief Number of statistics shards per stream
+     *
+     * Calling threads are spread over the shards so concurrent calls on one
+     * stream rarely update the same cache line.
+     */
+    constexpr size_t STATS_SHARDS = 8;
+
+    /**
+     * @brief Per-call counters for one group of calling threads
+     *
+     * Updated once per call with relaxed atomics and only summed when
+     * statistics are requested, so readers never hold up processing.
+     */
+    struct alignas(64) StatsShard {
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> busy_ns{0};
+        std::atomic<uint64_t> errors{0};
+    };
+
+    /**
+     * @brief Totals behind StreamStats, as saved in a checkpoint
+     */
+    struct StatsSnapshot {
+        uint64_t bytes = 0;
+        uint64_t busy_ns = 0;
+        uint64_t errors = 0;
+        uint64_t raw_bytes = 0;  ///< Encoder input
+        uint64_t encoded_bytes = 0;  ///< Encoder output, headers included
+        uint64_t encode_ns = 0;
+        uint64_t decode_ns = 0;
+    };
+
+    /**
+     * @brief StreamProcessor checkpoint layout, all fields little-endian
+     *
+     *   offset  size  field
+     *   0       4     CHECKPOINT_MAGIC
+     *   4       2     CHECKPOINT_VERSION
+     *   6       2     reserved, zero
+     *   8       8     buffer_size
+     *   16      1     compression
+     *   17      1     enable_checksum
+     *   18      1     StreamState
+     *   19      1     chunking
+     *   20      4     compression_level
+     *   24      4     dictionary size
+     *   28      4     dictionary CRC32C
+     *   32      56    StatsSnapshot, seven 8-byte counters in declaration order
+     *   88      8     pending partial chunk size P
+     *   96      8     queued output size Q
+     *   104     P     pending partial chunk
+     *   104+P   Q     queued output, oldest first
+     *   104+P+Q 4     CRC32C of everything above
+     */
+    constexpr uint32_t CHECKPOINT_MAGIC = 0x4B435044;  // "DPCK"
+    constexpr uint16_t CHECKPOINT_VERSION = 1;
+    constexpr size_t CHECKPOINT_HEADER_SIZE = 104;
+    constexpr size_t CHECKPOINT_TRAILER_SIZE = 4;
+
+    void append_le(std::vector<uint8_t>& output, uint64_t value, size_t bytes)
+    {
+        for (size_t i = 0; i < bytes; ++i) {
+            output.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    /**
+     * @brief Bounds-checked little-endian reads from a checkpoint
+     */
+    class CheckpointReader {
+    public:
+        explicit CheckpointReader(std::span<const uint8_t> data) noexcept : data_(data) {}
+
+        uint64_t read(size_t bytes) {
+            const auto field = take(bytes);
+            uint64_t value = 0;
+            for (size_t i = 0; i < bytes; ++i) {
+                value |= static_cast<uint64_t>(field[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        std::span<const uint8_t> take(size_t bytes) {
+            if (bytes > data_.size() - offset_) {
+                throw StreamInvalidArgumentException("checkpoint is truncated");
+            }
+            const auto field = data_.subspan(offset_, bytes);
+            offset_ += bytes;
+            return field;
+        }
+
+        size_t remaining() const noexcept { return data_.size() - offset_; }
+
+    private:
+        std::span<const uint8_t> data_;
+        size_t offset_ = 0;
+    };
+
+    /**
+     * @brief Shard used by the calling thread, fixed for the thread's lifetime
+     */
+    size_t stats_shard_index() noexcept
+    {
+        static std::atomic<size_t> next_index{0};
+        thread_local const size_t index = next_index.fetch_add(1, std::memory_order_relaxed) % STATS_SHARDS;
+        return index;
+    }
+
+    /**
+     * @brief How an input is divided into chunks and the chunks into worker tasks
+     *
+     * Every task holds chunks_per_task chunks (the last may hold fewer), so a
+     * task's output never exceeds chunks_per_task worst-case blocks whether
+     * the chunks are fixed or content-defined.
+     */
+    struct TaskLayout {
+        size_t input_size;
+        size_t chunk_size;  ///< Bytes per fixed chunk (one block when framed)
+        size_t chunks_per_task;
+        size_t chunk_count;
+        size_t task_count;
+        std::span<const size_t> chunk_ends;  ///< End of each content-defined chunk; empty for fixed chunks
+        std::span<const uint32_t> references;  ///< Per chunk, blocks back to an identical one (0 = none); empty without dedup
+
+        size_t chunk_begin(size_t chunk) const noexcept {
+            if (chunk_ends.empty()) {
+                return chunk * chunk_size;
+            }
+            return chunk == 0 ? 0 : chunk_ends[chunk - 1];
+        }
+
+        size_t chunk_end(size_t chunk) const noexcept {
+            return chunk_ends.empty() ? std::min(input_size, (chunk + 1) * chunk_size) : chunk_ends[chunk];
+        }
+
+        size_t first_chunk(size_t task) const noexcept { return task * chunks_per_task; }
+        size_t last_chunk(size_t task) const noexcept {
+            return std::min(chunk_count, first_chunk(task) + chunks_per_task);
+        }
+    };
+
+    /**
+     * @brief A run of consecutive messages encoded by one task of process_batch()
+     */
+    struct BatchTask {
+        size_t first_message;
+        size_t last_message;  ///< One past the task's last message
+        size_t region;  ///< Output position of the task's worst-case region
+        size_t written;  ///< Bytes the task encoded into its region
+        size_t first_reference;  ///< Index of the task's first chunk in batch_references
+    };
+
+    /**
+     * @brief Fill in defaults for unset configuration fields
+     */
+    StreamConfig resolve_config(StreamConfig config)
+    {
+        if (config.buffer_size == 0) {
+            config.buffer_size = DEFAULT_BUFFER_SIZE;
+        }
+        if (config.parallel_workers == 0) {
+            config.parallel_workers = 1;
+        }
+        config.parallel_workers = static_cast<uint32_t>(
+            std::min<size_t>(config.parallel_workers, MAX_PARALLEL_STREAMS));
+        validate_codec_config(config);
+        return config;
+    }
+
+    /**
+     * @brief Make room for @p extra more bytes with a single reallocation
+     *
+     * Growth stays geometric so callers appending call after call into the
+     * same vector do not pay for an exact-fit reallocation every time.
+     */
+    void reserve_for_append(std::vector<uint8_t>& output, size_t extra)
+    {
+        const size_t required = output.size() + extra;
+        if (required > output.capacity()) {
+            output.reserve(std::max(required, output.capacity() * 2));
+        }
+    }
 }
 
 /* ========================================================================== */
@@ -63,6 +279,30 @@ std::string to_string(CompressionType value)
     }
 }
 
+std::string to_string(FlowState value)
+{
+    switch (value) {
+        case FlowState::Open:
+            return "Open";
+        case FlowState::Paused:
+            return "Paused";
+        default:
+            return "Unknown";
+    }
+}
+
+std::string to_string(ChunkingMode value)
+{
+    switch (value) {
+        case ChunkingMode::Fixed:
+            return "Fixed";
+        case ChunkingMode::ContentDefined:
+            return "ContentDefined";
+        default:
+            return "Unknown";
+    }
+}
+
 
 /* ========================================================================== */
 /* Structure Operators                                                       */
@@ -74,7 +314,11 @@ bool StreamConfig::operator==(const StreamConfig& other) const noexcept
 max_memory == other.max_memory &&
 parallel_workers == other.parallel_workers &&
 compression == other.compression &&
-enable_checksum == other.enable_checksum;
+enable_checksum == other.enable_checksum &&
+compression_level == other.compression_level &&
+dictionary == other.dictionary &&
+chunking == other.chunking &&
+dedup_cache_entries == other.dedup_cache_entries;
 }
 
 bool StreamConfig::operator!=(const StreamConfig& other) const noexcept
@@ -87,7 +331,10 @@ bool StreamStats::operator==(const StreamStats& other) const noexcept
     return bytes_processed == other.bytes_processed &&
 processing_time_ms == other.processing_time_ms &&
 throughput_mbps == other.throughput_mbps &&
-error_count == other.error_count;
+error_count == other.error_count &&
+compressed_bytes == other.compressed_bytes &&
+compression_ratio == other.compression_ratio &&
+codec_time_ms == other.codec_time_ms;
 }
 
 bool StreamStats::operator!=(const StreamStats& other) const noexcept
@@ -96,6 +343,125 @@ bool StreamStats::operator!=(const StreamStats& other) const noexcept
 }
 
 
+/* ========================================================================== */
+/* StreamSegments Implementation                                             */
+/* ========================================================================== */
+
+struct StreamSegments::Storage {
+    std::vector<std::shared_ptr<BufferPool>> pools;  ///< Keeps the pools alive while leases are out
+    std::vector<BufferPool::Lease> leases;
+};
+
+StreamSegments::StreamSegments() = default;
+
+StreamSegments::~StreamSegments()
+{
+    release();
+}
+
+StreamSegments::StreamSegments(StreamSegments&& other) noexcept
+    : segments_(std::move(other.segments_)),
+      size_(std::exchange(other.size_, 0)),
+      storage_(std::move(other.storage_))
+{
+    other.segments_.clear();
+}
+
+StreamSegments& StreamSegments::operator=(StreamSegments&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        segments_ = std::move(other.segments_);
+        size_ = std::exchange(other.size_, 0);
+        storage_ = std::move(other.storage_);
+        other.segments_.clear();
+    }
+    return *this;
+}
+
+void StreamSegments::release() noexcept
+{
+    segments_.clear();
+    size_ = 0;
+    if (storage_) {
+        storage_->leases.clear();
+        storage_->pools.clear();
+    }
+}
+
+/* ========================================================================== */
+/* StreamFileWriter Implementation                                           */
+/* ========================================================================== */
+
+struct StreamFileWriter::Impl {
+    AsyncWriter writer;
+
+    Impl(int fd, size_t buffer_size, size_t queue_depth, bool use_io_uring)
+        : writer(fd, buffer_size, queue_depth, use_io_uring) {}
+};
+
+namespace {
+    /**
+     * @brief Largest buffer io_uring will register
+     */
+    constexpr size_t MAX_WRITE_BUFFER_SIZE = size_t{1} << 30;
+}
+
+StreamFileWriter::StreamFileWriter(int fd, size_t buffer_size, size_t queue_depth, bool use_io_uring)
+{
+    if (buffer_size == 0) {
+        buffer_size = DEFAULT_WRITE_BUFFER_SIZE;
+    }
+    if (buffer_size > MAX_WRITE_BUFFER_SIZE) {
+        throw StreamInvalidArgumentException("write buffer_size exceeds 1 GiB");
+    }
+    if (queue_depth == 0) {
+        queue_depth = DEFAULT_WRITE_QUEUE_DEPTH;
+    }
+    queue_depth = std::min(queue_depth, MAX_WRITE_QUEUE_DEPTH);
+    pimpl_ = std::make_unique<Impl>(fd, buffer_size, queue_depth, use_io_uring);
+}
+
+StreamFileWriter::~StreamFileWriter() = default;
+
+StreamFileWriter::StreamFileWriter(StreamFileWriter&& other) noexcept = default;
+
+StreamFileWriter& StreamFileWriter::operator=(StreamFileWriter&& other) noexcept = default;
+
+void StreamFileWriter::write(std::span<const uint8_t> data)
+{
+    if (!pimpl_) {
+        throw StreamRuntimeException("Invalid file writer instance");
+    }
+    pimpl_->writer.write(data);
+}
+
+void StreamFileWriter::flush()
+{
+    if (!pimpl_) {
+        throw StreamRuntimeException("Invalid file writer instance");
+    }
+    pimpl_->writer.flush();
+}
+
+StreamSink StreamFileWriter::sink()
+{
+    if (!pimpl_) {
+        throw StreamRuntimeException("Invalid file writer instance");
+    }
+    return [this](std::span<const uint8_t> piece) { write(piece); };
+}
+
+uint64_t StreamFileWriter::bytes_written() const noexcept
+{
+    return pimpl_ ? pimpl_->writer.bytes_queued() : 0;
+}
+
+bool StreamFileWriter::uses_io_uring() const noexcept
+{
+    return pimpl_ && std::strcmp(pimpl_->writer.backend_name(), "io_uring") == 0;
+}
+
 /* ========================================================================== */
 /* PIMPL Implementation                                                      */
 /* ========================================================================== */
@@ -104,9 +470,58 @@ struct Stream::Impl {
     bool valid;
     std::string last_error;
     uint32_t magic;
+    StreamConfig config;
+    std::unique_ptr<WorkerPool> workers;  ///< Null when running single-threaded
+    size_t chunks_per_task;  ///< Chunks handed to a worker at a time
+    std::optional<ContentChunker> chunker;  ///< Set for ChunkingMode::ContentDefined
+    std::unique_ptr<DedupCache> dedup;  ///< Set when dedup_cache_entries is non-zero; used under codec_mutex
 
-    Impl() : valid(false), magic(MAGIC_NUMBER) {
+    std::mutex codec_mutex;  ///< Serializes use of the codec state below
+    std::vector<BlockEncoder> encoders;  ///< One per worker, indexed by worker
+    std::vector<BlockDecoder> decoders;  ///< One per worker, indexed by worker
+    std::vector<FrameBlock> frame_blocks;  ///< Scratch for decode()
+    std::vector<size_t> task_sizes;  ///< Scratch for encode_parallel()
+    std::vector<size_t> chunk_ends;  ///< Scratch for task_layout() with content-defined chunks
+    std::vector<uint32_t> references;  ///< Scratch for task_layout() with deduplication
+    std::vector<uint32_t> batch_references;  ///< Scratch for process_batch() with deduplication
+    std::vector<BatchTask> batch_tasks;  ///< Scratch for process_batch()
+    size_t pool_budget;  ///< Part of max_memory the buffer pools below share (0 = no limit)
+    size_t pool_buffer_size = 0;  ///< Bytes per pool buffer, one task's encoded output
+    size_t pool_buffer_count = 0;  ///< Buffers per pool within pool_budget
+    std::unique_ptr<BufferPool> encode_buffers;  ///< Staging for encode_parallel(), within pool_budget
+    std::shared_ptr<BufferPool> segment_buffers;  ///< Backing for StreamSegments, created on first use; outlives the stream if held
+
+    std::array<StatsShard, STATS_SHARDS> stats;
+
+    /**
+     * @param reserved_memory Bytes of max_memory the owner keeps for its own
+     *        buffers; the pools fit in the rest
+     */
+    explicit Impl(const StreamConfig& cfg, size_t reserved_memory = 0)
+        : valid(false), magic(MAGIC_NUMBER), config(resolve_config(cfg)),
+          chunks_per_task(std::max<size_t>(1, PARALLEL_TASK_BYTES / config.buffer_size)),
+          pool_budget(budget_for_pools(config, reserved_memory)) {
         try {
+            if (config.parallel_workers > 1) {
+                // The calling thread is one of the workers
+                workers = std::make_unique<WorkerPool>(config.parallel_workers - 1);
+            }
+            if (config.chunking == ChunkingMode::ContentDefined) {
+                chunker.emplace(config.buffer_size);
+            }
+            if (config.dedup_cache_entries != 0) {
+                dedup = std::make_unique<DedupCache>(config.dedup_cache_entries);
+            }
+            if (uses_block_framing(config)) {
+                create_buffer_pools();
+                const auto shared = make_codec_shared(config);
+                encoders.reserve(concurrency());
+                decoders.reserve(concurrency());
+                for (size_t i = 0; i < concurrency(); ++i) {
+                    encoders.emplace_back(config, shared);
+                    decoders.emplace_back(config, shared);
+                }
+            }
             initialize();
             valid = true;
         } catch (const std::exception& e) {
@@ -145,6 +560,694 @@ struct Stream::Impl {
     bool is_valid() const noexcept {
         return valid && (magic == MAGIC_NUMBER);
     }
+
+    /**
+     * @brief The part of max_memory left to the buffer pools
+     *
+     * Each pool keeps at least one buffer of one encoded block, so a smaller
+     * budget could not be honoured and is rejected up front.
+     *
+     * @throws StreamInvalidArgumentException if the pools cannot fit
+     */
+    static size_t budget_for_pools(const StreamConfig& config, size_t reserved_memory) {
+        const size_t budget = config.max_memory - std::min(reserved_memory, config.max_memory);
+        if (config.max_memory != 0 && uses_block_framing(config)) {
+            const size_t pools = config.parallel_workers > 1 ? 2 : 1;
+            const size_t minimum = pools * max_encoded_block_size(config, config.buffer_size);
+            if (budget < minimum) {
+                throw StreamInvalidArgumentException(
+                    "max_memory leaves " + std::to_string(budget) + " bytes for buffer pools, which need " +
+                    std::to_string(minimum) + " (one encoded block for each of " + std::to_string(pools) + ")");
+            }
+        }
+        return budget;
+    }
+
+    /**
+     * @brief Size the task buffer pools to fit pool_budget together
+     *
+     * Without a budget every worker gets two task buffers per pool. With
+     * one, the pools split it evenly: tasks shrink until each worker can
+     * hold a buffer, and a pool holds as many buffers as fit in its share
+     * (at least one, at most the unbudgeted count). Encode staging is only
+     * needed with workers and is allocated here; the segment pool is left
+     * to segment_pool(), since most streams never return segments.
+     */
+    void create_buffer_pools() {
+        const size_t block = max_encoded_block_size(config, config.buffer_size);
+        size_t buffer_count = 2 * concurrency();
+        if (config.max_memory != 0) {
+            const size_t share = std::max<size_t>(1, pool_budget / (workers ? 2 : 1));
+            chunks_per_task = std::clamp<size_t>(share / (concurrency() * block), 1, chunks_per_task);
+            buffer_count = std::clamp<size_t>(share / (chunks_per_task * block), 1, buffer_count);
+        }
+        pool_buffer_size = chunks_per_task * block;
+        pool_buffer_count = buffer_count;
+        if (workers) {
+            encode_buffers = std::make_unique<BufferPool>(pool_buffer_size, pool_buffer_count);
+        }
+    }
+
+    /**
+     * @brief The segment pool, with at least @p needed buffers free
+     *
+     * Within a max_memory budget the pool never grows: a call needing more
+     * buffers than are free is refused, and the caller has to release
+     * segments it holds first. Without a budget a pool that runs short is
+     * replaced by one twice as large; segments still holding buffers of
+     * the old pool keep it alive until they are released.
+     *
+     * @throws StreamRuntimeException when the budgeted pool is short
+     */
+    const std::shared_ptr<BufferPool>& segment_pool(size_t needed) {
+        if (config.max_memory == 0) {
+            if (!segment_buffers) {
+                segment_buffers = std::make_shared<BufferPool>(pool_buffer_size, std::max(pool_buffer_count, needed));
+            } else if (segment_buffers->available() < needed) {
+                segment_buffers = std::make_shared<BufferPool>(
+                    pool_buffer_size, std::max(2 * segment_buffers->capacity(), needed));
+            }
+            return segment_buffers;
+        }
+
+        if (!segment_buffers) {
+            segment_buffers = std::make_shared<BufferPool>(pool_buffer_size, pool_buffer_count);
+        }
+        const size_t available = segment_buffers->available();
+        if (available < needed) {
+            throw StreamRuntimeException(
+                "segment buffers exhausted: " + std::to_string(needed) + " needed, " + std::to_string(available) +
+                " of " + std::to_string(segment_buffers->capacity()) +
+                " free; release held StreamSegments or raise max_memory");
+        }
+        return segment_buffers;
+    }
+
+    size_t concurrency() const noexcept {
+        return workers ? workers->concurrency() : 1;
+    }
+
+    bool runs_parallel(size_t bytes) const noexcept {
+        return workers && bytes > PARALLEL_TASK_BYTES;
+    }
+
+    /**
+     * @brief Length of the chunk at the start of @p rest, which runs to the end of input
+     */
+    size_t next_chunk(std::span<const uint8_t> rest) const noexcept {
+        return chunker ? chunker->next_chunk(rest) : std::min(config.buffer_size, rest.size());
+    }
+
+    /**
+     * @brief Bytes at the start of @p window that form whole chunks
+     *
+     * Content-defined chunks are cut where they would be cut in the whole
+     * input, so a window that is not the last stops at its final content cut
+     * and the next window starts there.
+     */
+    size_t whole_chunks(std::span<const uint8_t> window, bool last) const noexcept {
+        if (!chunker || last) {
+            return window.size();
+        }
+        size_t length = 0;
+        while (const size_t cut = chunker->find_cut(window.subspan(length))) {
+            length += cut;
+        }
+        return length;
+    }
+
+    /**
+     * @brief Split @p input into chunks and the chunks into worker tasks
+     *
+     * Content-defined chunks are found up front, into chunk_ends, and with
+     * deduplication every chunk is looked up in the cache, into references,
+     * so callers must hold codec_mutex in those modes.
+     */
+    TaskLayout task_layout(std::span<const uint8_t> input) {
+        TaskLayout layout{};
+        layout.input_size = input.size();
+        layout.chunk_size = config.buffer_size;
+        layout.chunks_per_task = chunks_per_task;
+        if (chunker) {
+            chunk_ends.clear();
+            for (size_t offset = 0; offset < input.size();) {
+                offset += chunker->next_chunk(input.subspan(offset));
+                chunk_ends.push_back(offset);
+            }
+            layout.chunk_ends = chunk_ends;
+            layout.chunk_count = chunk_ends.size();
+        } else {
+            layout.chunk_count = (input.size() + layout.chunk_size - 1) / layout.chunk_size;
+        }
+        layout.task_count = (layout.chunk_count + layout.chunks_per_task - 1) / layout.chunks_per_task;
+        if (dedup) {
+            // References stay within the call, so its output decodes on its own
+            dedup->begin();
+            references.resize(layout.chunk_count);
+            for (size_t chunk = 0; chunk < layout.chunk_count; ++chunk) {
+                const size_t offset = layout.chunk_begin(chunk);
+                references[chunk] = dedup->find_or_insert(input.subspan(offset, layout.chunk_end(chunk) - offset), chunk);
+            }
+            layout.references = references;
+        }
+        return layout;
+    }
+
+    /**
+     * @brief Encode one chunk of @p layout, as a back-reference when it repeats an earlier one
+     *
+     * Repeated chunks skip the codec entirely.
+     */
+    static size_t encode_chunk(BlockEncoder& encoder, std::span<const uint8_t> input, const TaskLayout& layout,
+                               size_t chunk, uint8_t* dst) {
+        const size_t offset = layout.chunk_begin(chunk);
+        const auto raw = input.subspan(offset, layout.chunk_end(chunk) - offset);
+        if (!layout.references.empty() && layout.references[chunk] != 0) {
+            return encoder.encode_reference(raw, layout.references[chunk], dst);
+        }
+        return encoder.encode(raw, dst);
+    }
+
+    void process(std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+        if (input.empty()) {
+            return;
+        }
+
+        if (uses_block_framing(config)) {
+            encode_frame(input, output);
+            return;
+        }
+
+        if (runs_parallel(input.size())) {
+            process_parallel(input, output);
+            return;
+        }
+
+        reserve_for_append(output, input.size());
+
+        const size_t chunk_size = config.buffer_size;
+        for (size_t offset = 0; offset < input.size(); offset += chunk_size) {
+            process_chunk(input.subspan(offset, std::min(chunk_size, input.size() - offset)), output);
+        }
+    }
+
+    void process_chunk(std::span<const uint8_t> chunk, std::vector<uint8_t>& output) const {
+        // Capacity was reserved by process(), so this is a straight copy
+        output.insert(output.end(), chunk.begin(), chunk.end());
+    }
+
+    void process_parallel(std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+        const TaskLayout layout = task_layout(input);
+
+        // Every task writes straight to its final position, so the output is
+        // in order without a separate reassembly pass
+        const size_t base = output.size();
+        reserve_for_append(output, input.size());
+        output.resize(base + input.size());
+        uint8_t* const destination = output.data() + base;
+
+        workers->parallel_for(layout.task_count, [&](size_t task, size_t) {
+            for (size_t chunk = layout.first_chunk(task); chunk < layout.last_chunk(task); ++chunk) {
+                const size_t offset = layout.chunk_begin(chunk);
+                std::memcpy(destination + offset, input.data() + offset, layout.chunk_end(chunk) - offset);
+            }
+        });
+    }
+
+    void encode_frame(std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+        std::lock_guard<std::mutex> lock(codec_mutex);
+
+        const size_t base = output.size();
+        try {
+            if (runs_parallel(input.size())) {
+                encode_parallel(input, output);
+            } else {
+                encode_sequential(input, output);
+            }
+        } catch (...) {
+            output.resize(base);
+            throw;
+        }
+    }
+
+    void encode_sequential(std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+        const TaskLayout layout = task_layout(input);
+        reserve_for_append(output, encoded_bound(input.size()));
+
+        BlockEncoder& encoder = encoders.back();
+        for (size_t chunk = 0; chunk < layout.chunk_count; ++chunk) {
+            const size_t position = output.size();
+            output.resize(position + max_encoded_block_size(config, layout.chunk_end(chunk) - layout.chunk_begin(chunk)));
+            output.resize(position + encode_chunk(encoder, input, layout, chunk, output.data() + position));
+        }
+    }
+
+    void encode_parallel(std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+        const TaskLayout layout = task_layout(input);
+
+        // Tasks encode into pool buffers one wave at a time and each wave is
+        // appended in order, so working memory stays within the pool however
+        // large the input is. A wave takes every free buffer, waiting only
+        // when there is none at all.
+        std::vector<BufferPool::Lease> leases;
+        leases.reserve(encode_buffers->capacity());
+        for (size_t first_task = 0; first_task < layout.task_count; first_task += leases.size()) {
+            leases.clear();
+            leases.push_back(encode_buffers->acquire());
+            while (leases.size() < layout.task_count - first_task) {
+                BufferPool::Lease lease = encode_buffers->try_acquire();
+                if (!lease) {
+                    break;
+                }
+                leases.push_back(std::move(lease));
+            }
+            task_sizes.assign(leases.size(), 0);
+
+            workers->parallel_for(leases.size(), [&](size_t slot, size_t worker) {
+                BlockEncoder& encoder = encoders[worker];
+                uint8_t* const buffer = leases[slot].data();
+                const size_t task = first_task + slot;
+                size_t written = 0;
+                for (size_t chunk = layout.first_chunk(task); chunk < layout.last_chunk(task); ++chunk) {
+                    written += encode_chunk(encoder, input, layout, chunk, buffer + written);
+                }
+                task_sizes[slot] = written;
+            });
+
+            for (size_t slot = 0; slot < leases.size(); ++slot) {
+                output.insert(output.end(), leases[slot].data(), leases[slot].data() + task_sizes[slot]);
+            }
+        }
+    }
+
+    /**
+     * @brief Encode into segment buffers, one per task, with no final copy
+     *
+     * Every buffer is leased from segment_pool() before any work starts, so
+     * a refused call leaves @p output as it was.
+     */
+    void process_segments(std::span<const uint8_t> input, StreamSegments& output,
+                          StreamSegments::Storage& storage) {
+        if (input.empty()) {
+            return;
+        }
+
+        if (!uses_block_framing(config)) {
+            output.segments_.push_back(input);
+            output.size_ += input.size();
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(codec_mutex);
+
+        const TaskLayout layout = task_layout(input);
+        const std::shared_ptr<BufferPool>& pool = segment_pool(layout.task_count);
+        const size_t base_segments = output.segments_.size();
+        const size_t base_leases = storage.leases.size();
+        const size_t base_size = output.size_;
+        if (storage.pools.empty() || storage.pools.back() != pool) {
+            storage.pools.push_back(pool);
+        }
+
+        try {
+            // Only this function leases segment buffers, under codec_mutex,
+            // so the free buffers segment_pool() found are still there
+            std::vector<uint8_t*> buffers(layout.task_count);
+            for (uint8_t*& buffer : buffers) {
+                storage.leases.push_back(pool->acquire());
+                buffer = storage.leases.back().data();
+            }
+            task_sizes.assign(layout.task_count, 0);
+
+            auto encode_task = [&](size_t task, size_t worker) {
+                BlockEncoder& encoder = encoders[worker];
+                size_t written = 0;
+                for (size_t chunk = layout.first_chunk(task); chunk < layout.last_chunk(task); ++chunk) {
+                    written += encode_chunk(encoder, input, layout, chunk, buffers[task] + written);
+                }
+                task_sizes[task] = written;
+            };
+            if (runs_parallel(input.size())) {
+                workers->parallel_for(layout.task_count, encode_task);
+            } else {
+                for (size_t task = 0; task < layout.task_count; ++task) {
+                    encode_task(task, concurrency() - 1);
+                }
+            }
+
+            for (size_t task = 0; task < layout.task_count; ++task) {
+                output.segments_.emplace_back(buffers[task], task_sizes[task]);
+                output.size_ += task_sizes[task];
+            }
+        } catch (...) {
+            output.segments_.resize(base_segments);
+            output.size_ = base_size;
+            storage.leases.resize(base_leases);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Input bytes per window when output goes to a sink
+     *
+     * Whole chunks per window keep the block layout identical to a single
+     * process_data() call over the same input; content-defined windows are
+     * further trimmed to their last cut by whole_chunks().
+     */
+    size_t window_bytes() const noexcept {
+        size_t bytes = SINK_WINDOW_BYTES;
+        if (config.max_memory != 0) {
+            bytes = std::min(bytes, config.max_memory / 2);
+        }
+        return std::max<size_t>(1, bytes / config.buffer_size) * config.buffer_size;
+    }
+
+    void process_to_sink(std::span<const uint8_t> input, const StreamSink& sink) {
+        if (!uses_block_framing(config)) {
+            if (!input.empty()) {
+                sink(input);
+            }
+            return;
+        }
+
+        const size_t window_size = window_bytes();
+        std::vector<uint8_t> window_output;
+        for (size_t offset = 0; offset < input.size();) {
+            const auto window = input.subspan(offset, std::min(window_size, input.size() - offset));
+            const size_t length = whole_chunks(window, offset + window.size() == input.size());
+            window_output.clear();
+            process(window.first(length), window_output);
+            sink(window_output);
+            offset += length;
+        }
+    }
+
+    /**
+     * @brief Largest output process() can produce for @p size input bytes
+     */
+    size_t encoded_bound(size_t size) const noexcept {
+        if (chunker) {
+            // Every chunk but the last is longer than min_size(), and the
+            // codec bounds grow no faster than linearly plus a fixed margin
+            const size_t chunk_count = size / chunker->min_size() + 1;
+            return max_encoded_block_size(config, size) + chunk_count * max_encoded_block_size(config, 0);
+        }
+        const size_t chunk_size = config.buffer_size;
+        const size_t remainder = size % chunk_size;
+        return (size / chunk_size) * max_encoded_block_size(config, chunk_size) +
+               (remainder != 0 ? max_encoded_block_size(config, remainder) : 0);
+    }
+
+    /**
+     * @brief Encode every message into one buffer with one lock and one resize
+     *
+     * The output is sized once for the worst case of the whole batch. With
+     * workers, consecutive messages are grouped into tasks of about one
+     * parallel task's worth of input; each task encodes into its own
+     * worst-case region and the regions are then slid together in order.
+     *
+     * @return size_t Input bytes in the batch
+     */
+    size_t process_batch(std::span<const std::span<const uint8_t>> inputs, std::vector<uint8_t>& output,
+                       std::vector<size_t>& offsets) {
+        const size_t base = output.size();
+        offsets.resize(inputs.size() + 1);
+
+        if (!uses_block_framing(config)) {
+            size_t total = 0;
+            for (const auto& input : inputs) {
+                total += input.size();
+            }
+            reserve_for_append(output, total);
+            output.resize(base + total);
+            size_t position = base;
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                offsets[i] = position;
+                if (!inputs[i].empty()) {
+                    std::memcpy(output.data() + position, inputs[i].data(), inputs[i].size());
+                }
+                position += inputs[i].size();
+            }
+            offsets[inputs.size()] = position;
+            return total;
+        }
+
+        std::lock_guard<std::mutex> lock(codec_mutex);
+
+        // Group messages into tasks, each owning a worst-case output region
+        const size_t task_bytes = chunks_per_task * config.buffer_size;
+        batch_tasks.clear();
+        batch_references.clear();
+        size_t total_bytes = 0;
+        size_t bound = 0;
+        size_t task_input = 0;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (batch_tasks.empty() || task_input >= task_bytes) {
+                batch_tasks.push_back(BatchTask{i, i, base + bound, 0, batch_references.size()});
+                task_input = 0;
+            }
+            batch_tasks.back().last_message = i + 1;
+            if (dedup) {
+                // Each message is its own scope, like a process_data() call
+                dedup->begin();
+                const auto input = inputs[i];
+                for (size_t offset = 0, chunk = 0; offset < input.size(); ++chunk) {
+                    const auto raw = input.subspan(offset, next_chunk(input.subspan(offset)));
+                    batch_references.push_back(dedup->find_or_insert(raw, chunk));
+                    offset += raw.size();
+                }
+            }
+            task_input += inputs[i].size();
+            total_bytes += inputs[i].size();
+            bound += encoded_bound(inputs[i].size());
+        }
+
+        try {
+            reserve_for_append(output, bound);
+            output.resize(base + bound);
+
+            auto encode_task = [&](size_t task, size_t worker) {
+                BlockEncoder& encoder = encoders[worker];
+                BatchTask& batch = batch_tasks[task];
+                size_t position = batch.region;
+                size_t reference = batch.first_reference;
+                for (size_t i = batch.first_message; i < batch.last_message; ++i) {
+                    const auto input = inputs[i];
+                    offsets[i] = position;
+                    for (size_t offset = 0; offset < input.size();) {
+                        const auto chunk = input.subspan(offset, next_chunk(input.subspan(offset)));
+                        const uint32_t distance = dedup ? batch_references[reference++] : 0;
+                        position += distance != 0 ? encoder.encode_reference(chunk, distance, output.data() + position)
+                                                  : encoder.encode(chunk, output.data() + position);
+                        offset += chunk.size();
+                    }
+                }
+                batch.written = position - batch.region;
+            };
+            if (runs_parallel(total_bytes) && batch_tasks.size() > 1) {
+                workers->parallel_for(batch_tasks.size(), encode_task);
+            } else {
+                for (size_t task = 0; task < batch_tasks.size(); ++task) {
+                    encode_task(task, concurrency() - 1);
+                }
+            }
+        } catch (...) {
+            output.resize(base);
+            offsets.clear();
+            throw;
+        }
+
+        // Close the gaps left by each region's unused worst-case tail
+        size_t position = base;
+        for (const BatchTask& batch : batch_tasks) {
+            if (batch.region != position) {
+                std::memmove(output.data() + position, output.data() + batch.region, batch.written);
+                for (size_t i = batch.first_message; i < batch.last_message; ++i) {
+                    offsets[i] -= batch.region - position;
+                }
+            }
+            position += batch.written;
+        }
+        offsets[inputs.size()] = position;
+        output.resize(position);
+        return total_bytes;
+    }
+
+    size_t process_file(MappedFile& file, const StreamSink& sink) {
+        const size_t window_size = window_bytes();
+        std::vector<uint8_t> window_output;
+        for (size_t offset = 0; offset < file.size();) {
+            const auto window = file.window(offset, std::min(window_size, file.size() - offset));
+            const size_t length = whole_chunks(window, offset + window.size() == file.size());
+            if (uses_block_framing(config)) {
+                window_output.clear();
+                process(window.first(length), window_output);
+                sink(window_output);
+            } else {
+                sink(window);
+            }
+            offset += length;
+            file.release_before(offset);
+        }
+        return file.size();
+    }
+
+    void record_call(size_t bytes, std::chrono::steady_clock::time_point start) noexcept {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start);
+        StatsShard& shard = stats[stats_shard_index()];
+        shard.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        shard.busy_ns.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+    }
+
+    void record_error() noexcept {
+        stats[stats_shard_index()].errors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sum the shards and codec counters
+     *
+     * Lock free: the encoder and decoder vectors never change after
+     * construction and every counter is read with a relaxed load, so a
+     * scrape may straddle an in-flight call but never waits for one.
+     */
+    void collect_statistics(StreamStats& result) const {
+        uint64_t busy_ns = 0;
+        uint64_t errors = 0;
+        for (const StatsShard& shard : stats) {
+            result.bytes_processed += shard.bytes.load(std::memory_order_relaxed);
+            busy_ns += shard.busy_ns.load(std::memory_order_relaxed);
+            errors += shard.errors.load(std::memory_order_relaxed);
+        }
+        result.processing_time_ms = busy_ns / 1000000;
+        result.error_count = static_cast<uint32_t>(std::min<uint64_t>(errors, UINT32_MAX));
+        if (busy_ns != 0) {
+            result.throughput_mbps = static_cast<double>(result.bytes_processed) / (1024.0 * 1024.0) /
+                                     (static_cast<double>(busy_ns) / 1e9);
+        }
+
+        uint64_t raw_bytes = 0;
+        uint64_t codec_ns = 0;
+        for (const BlockEncoder& encoder : encoders) {
+            raw_bytes += encoder.counters().raw_bytes.load(std::memory_order_relaxed);
+            result.compressed_bytes += encoder.counters().encoded_bytes.load(std::memory_order_relaxed);
+            codec_ns += encoder.counters().codec_ns.load(std::memory_order_relaxed);
+        }
+        for (const BlockDecoder& decoder : decoders) {
+            codec_ns += decoder.counters().codec_ns.load(std::memory_order_relaxed);
+        }
+
+        result.codec_time_ms = static_cast<double>(codec_ns) / 1e6;
+        if (result.compressed_bytes != 0) {
+            result.compression_ratio = static_cast<double>(raw_bytes) / static_cast<double>(result.compressed_bytes);
+        }
+    }
+
+    StatsSnapshot snapshot_statistics() const noexcept {
+        StatsSnapshot snapshot;
+        for (const StatsShard& shard : stats) {
+            snapshot.bytes += shard.bytes.load(std::memory_order_relaxed);
+            snapshot.busy_ns += shard.busy_ns.load(std::memory_order_relaxed);
+            snapshot.errors += shard.errors.load(std::memory_order_relaxed);
+        }
+        for (const BlockEncoder& encoder : encoders) {
+            snapshot.raw_bytes += encoder.counters().raw_bytes.load(std::memory_order_relaxed);
+            snapshot.encoded_bytes += encoder.counters().encoded_bytes.load(std::memory_order_relaxed);
+            snapshot.encode_ns += encoder.counters().codec_ns.load(std::memory_order_relaxed);
+        }
+        for (const BlockDecoder& decoder : decoders) {
+            snapshot.decode_ns += decoder.counters().codec_ns.load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+    /**
+     * @brief Replace every counter so the totals equal @p snapshot
+     */
+    void restore_statistics(const StatsSnapshot& snapshot) noexcept {
+        reset_statistics();
+        stats.front().bytes.store(snapshot.bytes, std::memory_order_relaxed);
+        stats.front().busy_ns.store(snapshot.busy_ns, std::memory_order_relaxed);
+        stats.front().errors.store(snapshot.errors, std::memory_order_relaxed);
+        if (!encoders.empty()) {
+            encoders.front().add_counters(snapshot.raw_bytes, snapshot.encoded_bytes, snapshot.encode_ns);
+            decoders.front().add_counters(0, 0, snapshot.decode_ns);
+        }
+    }
+
+    void reset_statistics() noexcept {
+        for (StatsShard& shard : stats) {
+            shard.bytes.store(0, std::memory_order_relaxed);
+            shard.busy_ns.store(0, std::memory_order_relaxed);
+            shard.errors.store(0, std::memory_order_relaxed);
+        }
+        for (BlockEncoder& encoder : encoders) {
+            encoder.reset_counters();
+        }
+        for (BlockDecoder& decoder : decoders) {
+            decoder.reset_counters();
+        }
+    }
+
+    void decode(std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+        if (input.empty()) {
+            return;
+        }
+
+        if (!uses_block_framing(config)) {
+            process(input, output);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(codec_mutex);
+
+        const size_t raw_size = scan_frame(input, frame_blocks);
+        const size_t base = output.size();
+        reserve_for_append(output, raw_size);
+        output.resize(base + raw_size);
+        uint8_t* const destination = output.data() + base;
+
+        // References copy from blocks that are not references, so those are
+        // all decoded in a first pass and the references in a second
+        const bool has_references = std::any_of(frame_blocks.begin(), frame_blocks.end(), [](const FrameBlock& block) {
+            return block.header.codec == BlockCodecId::Reference;
+        });
+        try {
+            for (const bool reference_pass : {false, true}) {
+                if (reference_pass && !has_references) {
+                    break;
+                }
+                auto decode_block = [&](size_t i, size_t worker) {
+                    const FrameBlock& block = frame_blocks[i];
+                    if ((block.header.codec == BlockCodecId::Reference) == reference_pass) {
+                        decoders[worker].decode(input, block, destination + block.raw_offset);
+                    }
+                };
+                if (runs_parallel(raw_size) && frame_blocks.size() > 1) {
+                    // Block sizes come from the encoder, so size tasks by the
+                    // average block rather than by our own buffer_size
+                    const size_t average_block = std::max<size_t>(1, raw_size / frame_blocks.size());
+                    const size_t blocks_per_task = std::max<size_t>(1, PARALLEL_TASK_BYTES / average_block);
+                    const size_t task_count = (frame_blocks.size() + blocks_per_task - 1) / blocks_per_task;
+
+                    workers->parallel_for(task_count, [&](size_t task, size_t worker) {
+                        const size_t first = task * blocks_per_task;
+                        const size_t last = std::min(frame_blocks.size(), first + blocks_per_task);
+                        for (size_t i = first; i < last; ++i) {
+                            decode_block(i, worker);
+                        }
+                    });
+                } else {
+                    for (size_t i = 0; i < frame_blocks.size(); ++i) {
+                        decode_block(i, concurrency() - 1);
+                    }
+                }
+            }
+        } catch (...) {
+            output.resize(base);
+            throw;
+        }
+    }
 };
 
 /* ========================================================================== */
@@ -152,7 +1255,12 @@ struct Stream::Impl {
 /* ========================================================================== */
 
 Stream::Stream()
-    : pimpl_(std::make_unique<Impl>())
+    : Stream(StreamConfig{})
+{
+}
+
+Stream::Stream(const StreamConfig& config)
+    : pimpl_(std::make_unique<Impl>(config))
 {
     if (!pimpl_->is_valid()) {
         throw StreamRuntimeException("Failed to initialize stream module");
@@ -187,22 +1295,25 @@ std::string Stream::get_last_error() const
     return pimpl_->last_error;
 }
 
-std::unique_ptr<StreamProcessor> Stream::create_stream(
-const StreamConfig config) const
+const StreamConfig& Stream::get_config() const
 {
     if (!is_valid()) {
         throw StreamRuntimeException("Invalid stream instance");
     }
+    return pimpl_->config;
+}
 
-    // Validate input parameters
-
-    try {
-        // TODO: Implement create_stream functionality
-        
-        // Placeholder implementation
-        std::unique_ptr<StreamProcessor> result{};
-        return result;
-        
+std::unique_ptr<StreamProcessor> Stream::create_stream(
+const StreamConfig& config) const
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream instance");
+    }
+
+    // Validate input parameters
+
+    try {
+        return std::make_unique<StreamProcessor>(config);
     } catch (const std::exception& e) {
         pimpl_->last_error = e.what();
         throw StreamRuntimeException("create_stream failed: " + std::string(e.what()));
@@ -216,22 +1327,132 @@ std::span<const uint8_t> input,std::vector<uint8_t>& output) const
         throw StreamRuntimeException("Invalid stream instance");
     }
 
-    // Validate input parameters
-    if (output.empty()) {
-        throw StreamInvalidArgumentException("output cannot be empty");
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        pimpl_->process(input, output);
+        pimpl_->record_call(input.size(), start);
+    } catch (const std::exception& e) {
+        pimpl_->record_error();
+        pimpl_->last_error = e.what();
+        throw StreamRuntimeException("process_data failed: " + std::string(e.what()));
+    }
+}
+
+void Stream::process_data(std::span<const uint8_t> input, StreamSegments& output) const
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream instance");
     }
 
+    const auto start = std::chrono::steady_clock::now();
     try {
-        // TODO: Implement process_data functionality
-        
-        // Placeholder implementation
-        
+        if (!output.storage_) {
+            output.storage_ = std::make_unique<StreamSegments::Storage>();
+        }
+        pimpl_->process_segments(input, output, *output.storage_);
+        pimpl_->record_call(input.size(), start);
+    } catch (const std::exception& e) {
+        pimpl_->record_error();
+        pimpl_->last_error = e.what();
+        throw StreamRuntimeException("process_data failed: " + std::string(e.what()));
+    }
+}
+
+void Stream::process_data(std::span<const uint8_t> input, const StreamSink& sink) const
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream instance");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        pimpl_->process_to_sink(input, sink);
+        pimpl_->record_call(input.size(), start);
     } catch (const std::exception& e) {
+        pimpl_->record_error();
         pimpl_->last_error = e.what();
         throw StreamRuntimeException("process_data failed: " + std::string(e.what()));
     }
 }
 
+void Stream::process_batch(std::span<const std::span<const uint8_t>> inputs, std::vector<uint8_t>& output,
+                           std::vector<size_t>& offsets) const
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream instance");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        const size_t bytes = pimpl_->process_batch(inputs, output, offsets);
+        pimpl_->record_call(bytes, start);
+    } catch (const std::exception& e) {
+        pimpl_->record_error();
+        pimpl_->last_error = e.what();
+        throw StreamRuntimeException("process_batch failed: " + std::string(e.what()));
+    }
+}
+
+void Stream::process_file(const std::string& path, const StreamSink& sink) const
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream instance");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        MappedFile file(path);
+        const size_t bytes = pimpl_->process_file(file, sink);
+        pimpl_->record_call(bytes, start);
+    } catch (const std::exception& e) {
+        pimpl_->record_error();
+        pimpl_->last_error = e.what();
+        throw StreamRuntimeException("process_file failed: " + std::string(e.what()));
+    }
+}
+
+void Stream::process_file(const std::string& path, std::vector<uint8_t>& output) const
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream instance");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const size_t base = output.size();
+    try {
+        MappedFile file(path);
+        // One reservation for the whole file, as process_data() makes for its input
+        reserve_for_append(output, uses_block_framing(pimpl_->config) ? pimpl_->encoded_bound(file.size())
+                                                                      : file.size());
+        const size_t bytes = pimpl_->process_file(file, [&output](std::span<const uint8_t> piece) {
+            output.insert(output.end(), piece.begin(), piece.end());
+        });
+        pimpl_->record_call(bytes, start);
+    } catch (const std::exception& e) {
+        output.resize(base);
+        pimpl_->record_error();
+        pimpl_->last_error = e.what();
+        throw StreamRuntimeException("process_file failed: " + std::string(e.what()));
+    }
+}
+
+void Stream::decode_data(std::span<const uint8_t> input, std::vector<uint8_t>& output) const
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream instance");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        pimpl_->decode(input, output);
+        pimpl_->record_call(input.size(), start);
+    } catch (const std::exception& e) {
+        pimpl_->record_error();
+        pimpl_->last_error = e.what();
+        throw StreamRuntimeException("decode_data failed: " + std::string(e.what()));
+    }
+}
+
 StreamStats Stream::get_statistics(
 ) const
 {
@@ -242,12 +1463,9 @@ StreamStats Stream::get_statistics(
     // Validate input parameters
 
     try {
-        // TODO: Implement get_statistics functionality
-        
-        // Placeholder implementation
         StreamStats result{};
+        pimpl_->collect_statistics(result);
         return result;
-        
     } catch (const std::exception& e) {
         pimpl_->last_error = e.what();
         throw StreamRuntimeException("get_statistics failed: " + std::string(e.what()));
@@ -264,10 +1482,7 @@ void Stream::reset(
     // Validate input parameters
 
     try {
-        // TODO: Implement reset functionality
-        
-        // Placeholder implementation
-        
+        pimpl_->reset_statistics();
     } catch (const std::exception& e) {
         pimpl_->last_error = e.what();
         throw StreamRuntimeException("reset failed: " + std::string(e.what()));
@@ -275,6 +1490,775 @@ void Stream::reset(
 }
 
 
+/* ========================================================================== */
+/* StreamProcessor Class Implementation                                      */
+/* ========================================================================== */
+
+struct StreamProcessor::Impl {
+    /**
+     * @brief Drained output buffers kept for reuse by queued pushes
+     */
+    static constexpr size_t SPARE_OUTPUT_BUFFERS = 4;
+
+    std::unique_ptr<Stream::Impl> engine;
+    std::vector<uint8_t> pending;  ///< Partial chunk, capacity reserved up front
+    std::atomic<StreamState> state{StreamState::Idle};
+    std::string last_error;
+
+    std::mutex queue_mutex;  ///< Guards everything below except the atomics
+    std::deque<std::vector<uint8_t>> queue;  ///< Output waiting for drain()
+    std::vector<std::vector<uint8_t>> spare;
+    size_t queued_bytes = 0;
+    size_t pending_size = 0;  ///< pending.size() as of the producer's last call
+    StreamFlowControl flow;
+    std::atomic<FlowState> flow_state{FlowState::Open};
+    std::atomic<size_t> buffered{0};
+    std::atomic<size_t> depth{0};
+    std::atomic<size_t> pending_published{0};  ///< pending_size, readable from any thread
+    std::vector<StreamOperation*> waiters;  ///< Coroutines suspended in async_push() or async_flush()
+    std::deque<FlowState> flow_changes;  ///< Transitions recorded for on_change, not yet delivered
+    bool delivering_flow_changes = false;  ///< A thread is running deliver_flow_changes()
+
+    /**
+     * @brief Part of max_memory kept for pending and queued bytes
+     *
+     * The engine's buffer pools fit in the other half, so one max_memory
+     * budget covers everything the processor holds while its consumer keeps
+     * up with the default high watermark.
+     */
+    static size_t buffered_budget(const StreamConfig& config) noexcept {
+        return config.max_memory / 2;
+    }
+
+    explicit Impl(const StreamConfig& config)
+        : engine(std::make_unique<Stream::Impl>(config, buffered_budget(config))) {
+        if (!engine->is_valid()) {
+            throw StreamRuntimeException("Failed to initialize stream processor: " + engine->last_error);
+        }
+        pending.reserve(engine->config.buffer_size);
+        set_flow_control({});
+    }
+
+    ~Impl() {
+        // Waiting coroutines would otherwise never resume; fail their co_await
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        for (StreamOperation* operation : waiters) {
+            operation->error_ = std::make_exception_ptr(
+                StreamRuntimeException("stream processor destroyed while an operation was waiting"));
+            operation->executor_->post(operation->continuation_);
+        }
+    }
+
+    void set_flow_control(StreamFlowControl next) {
+        if (next.high_watermark == 0) {
+            next.high_watermark = engine->config.max_memory != 0 ? std::max<size_t>(1, buffered_budget(engine->config))
+                                                                 : DEFAULT_HIGH_WATERMARK;
+        }
+        if (next.low_watermark == 0) {
+            next.low_watermark = next.high_watermark / 2;
+        }
+        if (next.low_watermark >= next.high_watermark) {
+            throw StreamInvalidArgumentException("low_watermark must be below high_watermark");
+        }
+
+        bool deliver;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            flow = std::move(next);
+            deliver = update_flow_locked();
+        }
+        if (deliver) {
+            deliver_flow_changes();
+        }
+    }
+
+    /**
+     * @brief Publish the buffered totals and record a transition if one is due
+     * @return true if the caller must call deliver_flow_changes() once it has
+     *         released queue_mutex
+     */
+    bool update_flow_locked() {
+        const size_t bytes = pending_size + queued_bytes;
+        buffered.store(bytes, std::memory_order_relaxed);
+        depth.store(queue.size(), std::memory_order_relaxed);
+        pending_published.store(pending_size, std::memory_order_relaxed);
+
+        const FlowState current = flow_state.load(std::memory_order_relaxed);
+        FlowState next = current;
+        if (current == FlowState::Open) {
+            if (bytes >= flow.high_watermark ||
+                (flow.max_queue_depth != 0 && queue.size() >= flow.max_queue_depth)) {
+                next = FlowState::Paused;
+            }
+        } else if (bytes <= flow.low_watermark &&
+                   (flow.max_queue_depth == 0 || queue.size() <= flow.max_queue_depth / 2)) {
+            next = FlowState::Open;
+        }
+
+        bool deliver = false;
+        if (next != current) {
+            flow_state.store(next);
+            if (flow.on_change) {
+                flow_changes.push_back(next);
+                deliver = !delivering_flow_changes;
+                delivering_flow_changes = true;
+            }
+        }
+        if (!waiters.empty()) {
+            resume_waiters_locked();
+        }
+        return deliver;
+    }
+
+    /**
+     * @brief Run on_change for each recorded transition, in order, unlocked
+     *
+     * One thread delivers at a time. Transitions recorded meanwhile, by
+     * another thread or by a callback that pushes or drains, join the queue
+     * and are delivered by this loop, so callbacks never nest or reorder.
+     */
+    void deliver_flow_changes() {
+        for (;;) {
+            FlowState next;
+            std::function<void(FlowState)> callback;
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                if (flow_changes.empty() || !flow.on_change) {
+                    flow_changes.clear();
+                    delivering_flow_changes = false;
+                    return;
+                }
+                next = flow_changes.front();
+                flow_changes.pop_front();
+                callback = flow.on_change;
+            }
+
+            try {
+                callback(next);
+            } catch (...) {
+                // Leave the rest queued for whichever call records the next transition
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                delivering_flow_changes = false;
+                throw;
+            }
+        }
+    }
+
+    bool can_continue_locked(const StreamOperation& operation) const noexcept {
+        if (operation.kind_ == StreamOperation::Kind::Push) {
+            return flow_state.load(std::memory_order_relaxed) == FlowState::Open;
+        }
+        return queue.empty();
+    }
+
+    /**
+     * @brief Suspend @p operation until it can continue
+     * @return false if it can continue already
+     */
+    bool park(StreamOperation& operation) {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (can_continue_locked(operation)) {
+            return false;
+        }
+        waiters.push_back(&operation);
+        return true;
+    }
+
+    /**
+     * @brief Hand every waiter that can continue back to its executor
+     *
+     * A posted coroutine may run and free its operation at once, so each
+     * one leaves the list before it is posted and is not touched again.
+     */
+    void resume_waiters_locked() {
+        size_t kept = 0;
+        for (size_t i = 0; i < waiters.size(); ++i) {
+            StreamOperation* const operation = waiters[i];
+            if (can_continue_locked(*operation)) {
+                operation->executor_->post(operation->continuation_);
+            } else {
+                waiters[kept++] = operation;
+            }
+        }
+        waiters.resize(kept);
+    }
+
+    void note_pending() {
+        bool deliver;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            pending_size = pending.size();
+            deliver = update_flow_locked();
+        }
+        if (deliver) {
+            deliver_flow_changes();
+        }
+    }
+
+    std::vector<uint8_t> take_spare() {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (spare.empty()) {
+            return {};
+        }
+        std::vector<uint8_t> buffer = std::move(spare.back());
+        spare.pop_back();
+        return buffer;
+    }
+
+    void recycle_locked(std::vector<uint8_t>&& buffer) {
+        if (spare.size() < SPARE_OUTPUT_BUFFERS) {
+            buffer.clear();
+            spare.push_back(std::move(buffer));
+        }
+    }
+
+    void enqueue(std::vector<uint8_t>&& output) {
+        bool deliver;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            pending_size = pending.size();
+            if (output.empty()) {
+                recycle_locked(std::move(output));
+            } else {
+                queued_bytes += output.size();
+                queue.push_back(std::move(output));
+            }
+            deliver = update_flow_locked();
+        }
+        if (deliver) {
+            deliver_flow_changes();
+        }
+    }
+
+    size_t drain(std::vector<uint8_t>& output) {
+        std::deque<std::vector<uint8_t>> taken;
+        size_t bytes;
+        bool deliver;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            taken.swap(queue);
+            bytes = std::exchange(queued_bytes, 0);
+            deliver = update_flow_locked();
+        }
+        if (deliver) {
+            deliver_flow_changes();
+        }
+
+        // Copy without the lock so the producer can keep queueing
+        reserve_for_append(output, bytes);
+        for (const auto& entry : taken) {
+            output.insert(output.end(), entry.begin(), entry.end());
+        }
+
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        for (auto& entry : taken) {
+            recycle_locked(std::move(entry));
+        }
+        return bytes;
+    }
+
+    size_t drain(const StreamSink& sink) {
+        size_t bytes = 0;
+        for (;;) {
+            std::vector<uint8_t> entry;
+            bool deliver;
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                if (queue.empty()) {
+                    return bytes;
+                }
+                entry = std::move(queue.front());
+                queue.pop_front();
+                queued_bytes -= entry.size();
+                deliver = update_flow_locked();
+            }
+            if (deliver) {
+                deliver_flow_changes();
+            }
+
+            sink(entry);
+            bytes += entry.size();
+
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            recycle_locked(std::move(entry));
+        }
+    }
+
+    void clear_queue() {
+        bool deliver;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            queue.clear();
+            queued_bytes = 0;
+            pending_size = pending.size();
+            deliver = update_flow_locked();
+        }
+        if (deliver) {
+            deliver_flow_changes();
+        }
+    }
+
+    void checkpoint(std::vector<uint8_t>& output) {
+        const StreamConfig& config = engine->config;
+        const uint32_t dictionary_crc = checksum::crc32c(0, config.dictionary.data(), config.dictionary.size());
+        const StatsSnapshot snapshot = engine->snapshot_statistics();
+
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        const size_t base = output.size();
+        reserve_for_append(output, CHECKPOINT_HEADER_SIZE + pending.size() + queued_bytes + CHECKPOINT_TRAILER_SIZE);
+        append_le(output, CHECKPOINT_MAGIC, 4);
+        append_le(output, CHECKPOINT_VERSION, 2);
+        append_le(output, 0, 2);
+        append_le(output, config.buffer_size, 8);
+        append_le(output, static_cast<uint8_t>(config.compression), 1);
+        append_le(output, config.enable_checksum ? 1 : 0, 1);
+        append_le(output, static_cast<uint8_t>(state.load()), 1);
+        append_le(output, static_cast<uint8_t>(config.chunking), 1);
+        append_le(output, static_cast<uint32_t>(config.compression_level), 4);
+        append_le(output, config.dictionary.size(), 4);
+        append_le(output, dictionary_crc, 4);
+        for (const uint64_t counter : {snapshot.bytes, snapshot.busy_ns, snapshot.errors, snapshot.raw_bytes,
+                                       snapshot.encoded_bytes, snapshot.encode_ns, snapshot.decode_ns}) {
+            append_le(output, counter, 8);
+        }
+        append_le(output, pending.size(), 8);
+        append_le(output, queued_bytes, 8);
+        output.insert(output.end(), pending.begin(), pending.end());
+        for (const auto& entry : queue) {
+            output.insert(output.end(), entry.begin(), entry.end());
+        }
+        append_le(output, checksum::crc32c(0, output.data() + base, output.size() - base), 4);
+    }
+
+    /**
+     * @brief Validate @p checkpoint completely, then replace the current state with it
+     */
+    void restore(std::span<const uint8_t> checkpoint) {
+        if (checkpoint.size() < CHECKPOINT_HEADER_SIZE + CHECKPOINT_TRAILER_SIZE) {
+            throw StreamInvalidArgumentException("checkpoint is truncated");
+        }
+        const auto body = checkpoint.first(checkpoint.size() - CHECKPOINT_TRAILER_SIZE);
+        const uint64_t stored_crc = CheckpointReader(checkpoint.subspan(body.size())).read(4);
+        if (stored_crc != checksum::crc32c(0, body.data(), body.size())) {
+            throw StreamInvalidArgumentException("checkpoint checksum mismatch");
+        }
+
+        CheckpointReader reader(body);
+        if (reader.read(4) != CHECKPOINT_MAGIC) {
+            throw StreamInvalidArgumentException("not a stream processor checkpoint");
+        }
+        if (reader.read(2) != CHECKPOINT_VERSION) {
+            throw StreamInvalidArgumentException("unsupported checkpoint version");
+        }
+        reader.read(2);
+
+        const StreamConfig& config = engine->config;
+        const uint64_t buffer_size = reader.read(8);
+        const uint64_t compression = reader.read(1);
+        const uint64_t checksum_enabled = reader.read(1);
+        const uint64_t saved_state = reader.read(1);
+        const uint64_t chunking = reader.read(1);
+        const uint64_t level = reader.read(4);
+        const uint64_t dictionary_size = reader.read(4);
+        const uint64_t dictionary_crc = reader.read(4);
+        if (buffer_size != config.buffer_size || compression != static_cast<uint8_t>(config.compression) ||
+            checksum_enabled != (config.enable_checksum ? 1u : 0u) ||
+            chunking != static_cast<uint8_t>(config.chunking) ||
+            level != static_cast<uint32_t>(config.compression_level) ||
+            dictionary_size != config.dictionary.size() ||
+            dictionary_crc != checksum::crc32c(0, config.dictionary.data(), config.dictionary.size())) {
+            throw StreamInvalidArgumentException("checkpoint was taken with a different stream configuration");
+        }
+        if (saved_state > static_cast<uint8_t>(StreamState::Error)) {
+            throw StreamInvalidArgumentException("checkpoint has an invalid stream state");
+        }
+
+        StatsSnapshot snapshot;
+        for (uint64_t* counter : {&snapshot.bytes, &snapshot.busy_ns, &snapshot.errors, &snapshot.raw_bytes,
+                                  &snapshot.encoded_bytes, &snapshot.encode_ns, &snapshot.decode_ns}) {
+            *counter = reader.read(8);
+        }
+        const uint64_t pending_length = reader.read(8);
+        const uint64_t queued_length = reader.read(8);
+        if (pending_length >= config.buffer_size || queued_length != reader.remaining() - pending_length) {
+            throw StreamInvalidArgumentException("checkpoint sizes are inconsistent");
+        }
+        const auto saved_pending = reader.take(pending_length);
+        const auto saved_queue = reader.take(queued_length);
+
+        // Nothing below throws except on allocation, after which the
+        // processor is reset rather than left half restored
+        bool deliver;
+        try {
+            pending.assign(saved_pending.begin(), saved_pending.end());
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            queue.clear();
+            queued_bytes = 0;
+            if (!saved_queue.empty()) {
+                queue.emplace_back(saved_queue.begin(), saved_queue.end());
+                queued_bytes = saved_queue.size();
+            }
+            pending_size = pending.size();
+            deliver = update_flow_locked();
+        } catch (...) {
+            pending.clear();
+            clear_queue();
+            state.store(StreamState::Idle);
+            throw;
+        }
+        state.store(static_cast<StreamState>(saved_state));
+        engine->restore_statistics(snapshot);
+        if (deliver) {
+            deliver_flow_changes();
+        }
+    }
+
+    void require_open(const char* operation) const {
+        const StreamState current = state.load();
+        if (current == StreamState::Completed || current == StreamState::Error) {
+            throw StreamRuntimeException(std::string(operation) + " called on a " + to_string(current) +
+                                         " stream processor");
+        }
+    }
+
+    void run(std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+        const auto start = std::chrono::steady_clock::now();
+        engine->process(input, output);
+        engine->record_call(input.size(), start);
+    }
+
+    void push(std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+        if (engine->chunker) {
+            push_content_defined(input, output);
+            return;
+        }
+
+        const size_t chunk_size = engine->config.buffer_size;
+
+        if (!pending.empty()) {
+            const size_t take = std::min(input.size(), chunk_size - pending.size());
+            pending.insert(pending.end(), input.begin(), input.begin() + static_cast<std::ptrdiff_t>(take));
+            input = input.subspan(take);
+            if (pending.size() < chunk_size) {
+                return;
+            }
+            run(pending, output);
+            pending.clear();
+        }
+
+        // Whole chunks go straight from the caller's buffer to the engine
+        const size_t whole = input.size() - input.size() % chunk_size;
+        if (whole != 0) {
+            run(input.first(whole), output);
+        }
+        pending.assign(input.begin() + static_cast<std::ptrdiff_t>(whole), input.end());
+    }
+
+    /**
+     * @brief push() with content-defined chunks: hold back what follows the last cut
+     *
+     * A cut depends only on the bytes since the previous one, so once the
+     * pending bytes contain a cut that chunk is final, and pending never
+     * reaches buffer_size.
+     */
+    void push_content_defined(std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+        const ContentChunker& chunker = *engine->chunker;
+
+        if (!pending.empty()) {
+            const size_t held = pending.size();
+            const size_t take = std::min(input.size(), chunker.max_size() - held);
+            pending.insert(pending.end(), input.begin(), input.begin() + static_cast<std::ptrdiff_t>(take));
+            const size_t cut = chunker.find_cut(pending);
+            if (cut == 0) {
+                return;
+            }
+            // No cut was found in the held bytes, so this one lies past them
+            run(std::span<const uint8_t>(pending).first(cut), output);
+            input = input.subspan(cut - held);
+            pending.clear();
+        }
+
+        const size_t whole = engine->whole_chunks(input, false);
+        if (whole != 0) {
+            run(input.first(whole), output);
+        }
+        pending.assign(input.begin() + static_cast<std::ptrdiff_t>(whole), input.end());
+    }
+
+    void flush(std::vector<uint8_t>& output) {
+        if (!pending.empty()) {
+            run(pending, output);
+            pending.clear();
+        }
+    }
+
+    /**
+     * @brief Run @p operation, moving to Error and wrapping any failure
+     */
+    template <typename Operation>
+    void guarded(const char* name, Operation&& operation) {
+        try {
+            operation();
+        } catch (const std::exception& e) {
+            state.store(StreamState::Error);
+            engine->record_error();
+            last_error = e.what();
+            throw StreamRuntimeException(std::string(name) + " failed: " + e.what());
+        }
+    }
+};
+
+StreamProcessor::StreamProcessor(const StreamConfig& config)
+    : pimpl_(std::make_unique<Impl>(config))
+{
+}
+
+StreamProcessor::~StreamProcessor() = default;
+
+StreamProcessor::StreamProcessor(StreamProcessor&& other) noexcept
+    : pimpl_(std::move(other.pimpl_))
+{
+}
+
+StreamProcessor& StreamProcessor::operator=(StreamProcessor&& other) noexcept
+{
+    if (this != &other) {
+        pimpl_ = std::move(other.pimpl_);
+    }
+    return *this;
+}
+
+bool StreamProcessor::is_valid() const noexcept
+{
+    return pimpl_ && pimpl_->engine->is_valid();
+}
+
+std::string StreamProcessor::get_last_error() const
+{
+    if (!pimpl_) {
+        return "Invalid instance";
+    }
+    return pimpl_->last_error;
+}
+
+void StreamProcessor::push(std::span<const uint8_t> input, std::vector<uint8_t>& output)
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    pimpl_->require_open("push");
+
+    pimpl_->guarded("push", [&] {
+        pimpl_->state.store(StreamState::Processing);
+        pimpl_->push(input, output);
+        pimpl_->note_pending();
+    });
+}
+
+void StreamProcessor::flush(std::vector<uint8_t>& output)
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    pimpl_->require_open("flush");
+
+    pimpl_->guarded("flush", [&] {
+        pimpl_->flush(output);
+        pimpl_->note_pending();
+    });
+}
+
+void StreamProcessor::finish(std::vector<uint8_t>& output)
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    pimpl_->require_open("finish");
+
+    pimpl_->guarded("finish", [&] {
+        pimpl_->flush(output);
+        pimpl_->note_pending();
+        pimpl_->state.store(StreamState::Completed);
+    });
+}
+
+void StreamProcessor::push(std::span<const uint8_t> input)
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    pimpl_->require_open("push");
+
+    pimpl_->guarded("push", [&] {
+        pimpl_->state.store(StreamState::Processing);
+        std::vector<uint8_t> output = pimpl_->take_spare();
+        pimpl_->push(input, output);
+        pimpl_->enqueue(std::move(output));
+    });
+}
+
+void StreamProcessor::flush()
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    pimpl_->require_open("flush");
+
+    pimpl_->guarded("flush", [&] {
+        std::vector<uint8_t> output = pimpl_->take_spare();
+        pimpl_->flush(output);
+        pimpl_->enqueue(std::move(output));
+    });
+}
+
+void StreamProcessor::finish()
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    pimpl_->require_open("finish");
+
+    pimpl_->guarded("finish", [&] {
+        std::vector<uint8_t> output = pimpl_->take_spare();
+        pimpl_->flush(output);
+        pimpl_->enqueue(std::move(output));
+        pimpl_->state.store(StreamState::Completed);
+    });
+}
+
+size_t StreamProcessor::drain(std::vector<uint8_t>& output)
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    return pimpl_->drain(output);
+}
+
+size_t StreamProcessor::drain(const StreamSink& sink)
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    return pimpl_->drain(sink);
+}
+
+StreamOperation StreamProcessor::async_push(std::span<const uint8_t> input, StreamExecutor& executor)
+{
+    return StreamOperation(*this, executor, StreamOperation::Kind::Push, input);
+}
+
+StreamOperation StreamProcessor::async_flush(StreamExecutor& executor)
+{
+    return StreamOperation(*this, executor, StreamOperation::Kind::Flush, {});
+}
+
+void StreamProcessor::set_flow_control(StreamFlowControl flow)
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    pimpl_->set_flow_control(std::move(flow));
+}
+
+FlowState StreamProcessor::flow_state() const noexcept
+{
+    return pimpl_ ? pimpl_->flow_state.load() : FlowState::Open;
+}
+
+size_t StreamProcessor::buffered_bytes() const noexcept
+{
+    return pimpl_ ? pimpl_->buffered.load(std::memory_order_relaxed) : 0;
+}
+
+size_t StreamProcessor::queue_depth() const noexcept
+{
+    return pimpl_ ? pimpl_->depth.load(std::memory_order_relaxed) : 0;
+}
+
+void StreamProcessor::reset()
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    pimpl_->pending.clear();
+    pimpl_->clear_queue();
+    pimpl_->state.store(StreamState::Idle);
+}
+
+void StreamProcessor::checkpoint(std::vector<uint8_t>& output) const
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    pimpl_->checkpoint(output);
+}
+
+void StreamProcessor::restore(std::span<const uint8_t> checkpoint)
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    pimpl_->restore(checkpoint);
+}
+
+StreamState StreamProcessor::state() const noexcept
+{
+    return pimpl_ ? pimpl_->state.load() : StreamState::Error;
+}
+
+size_t StreamProcessor::pending_bytes() const noexcept
+{
+    return pimpl_ ? pimpl_->pending_published.load(std::memory_order_relaxed) : 0;
+}
+
+StreamStats StreamProcessor::get_statistics() const
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    StreamStats result{};
+    pimpl_->engine->collect_statistics(result);
+    return result;
+}
+
+const StreamConfig& StreamProcessor::get_config() const
+{
+    if (!is_valid()) {
+        throw StreamRuntimeException("Invalid stream processor instance");
+    }
+    return pimpl_->engine->config;
+}
+
+/* ========================================================================== */
+/* StreamOperation Implementation                                            */
+/* ========================================================================== */
+
+bool StreamOperation::await_suspend(std::coroutine_handle<> handle)
+{
+    try {
+        if (kind_ == Kind::Push) {
+            processor_->push(input_);
+        } else {
+            processor_->flush();
+        }
+    } catch (...) {
+        error_ = std::current_exception();
+        return false;
+    }
+
+    // Once parked, a drain() on another thread may resume and free this
+    // operation at any moment, so nothing below may touch it
+    continuation_ = handle;
+    return processor_->pimpl_->park(*this);
+}
+
+void StreamOperation::await_resume()
+{
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
 /* ========================================================================== */
 /* Free Function Implementations                                             */
 /* ========================================================================== */
@@ -289,7 +2273,7 @@ std::string get_build_info()
     std::ostringstream oss;
     oss << "dataprocessor v2.1.0\n";
     oss << "Built on: 2025-06-19\n";
-    oss << "Language: C++17\n";
+    oss << "Language: C++20\n";
     oss << "Compiler: " << 
 #ifdef __clang__
         "Clang " << __clang_major__ << "." << __clang_minor__ << "." << __clang_patchlevel__;
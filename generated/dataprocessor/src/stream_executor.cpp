@@ -0,0 +1,137 @@
+/**
+ * @file stream_executor.cpp
+ * @brief Implementation of the coroutine executor
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "stream_executor.h"
+#include "stream.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dataproc {
+
+/* ========================================================================== */
+/* StreamExecutor Implementation                                             */
+/* ========================================================================== */
+
+struct StreamExecutor::Impl {
+    std::mutex mutex;  ///< Guards everything below except threads
+    std::condition_variable ready;  ///< Signalled on new work and on shutdown
+    std::condition_variable idle;  ///< Signalled when the last spawned task completes
+    std::deque<std::coroutine_handle<>> queue;
+    size_t outstanding = 0;  ///< Spawned tasks not yet completed
+    std::exception_ptr failure;  ///< First exception from a spawned task
+    bool stopping = false;
+    std::vector<std::thread> threads;
+
+    void run() {
+        for (;;) {
+            std::coroutine_handle<> handle;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [&] { return stopping || !queue.empty(); });
+                if (queue.empty()) {
+                    return;
+                }
+                handle = queue.front();
+                queue.pop_front();
+            }
+            handle.resume();
+        }
+    }
+};
+
+StreamExecutor::StreamExecutor(size_t threads)
+    : pimpl_(std::make_unique<Impl>())
+{
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    try {
+        pimpl_->threads.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            pimpl_->threads.emplace_back([this] { pimpl_->run(); });
+        }
+    } catch (const std::exception& e) {
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex);
+            pimpl_->stopping = true;
+        }
+        pimpl_->ready.notify_all();
+        for (auto& thread : pimpl_->threads) {
+            thread.join();
+        }
+        throw StreamRuntimeException("Failed to start executor threads: " + std::string(e.what()));
+    }
+}
+
+StreamExecutor::~StreamExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex);
+        pimpl_->stopping = true;
+    }
+    pimpl_->ready.notify_all();
+    for (auto& thread : pimpl_->threads) {
+        thread.join();
+    }
+}
+
+void StreamExecutor::post(std::coroutine_handle<> handle)
+{
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex);
+        pimpl_->queue.push_back(handle);
+    }
+    pimpl_->ready.notify_one();
+}
+
+void StreamExecutor::spawn(StreamTask task)
+{
+    if (!task.handle_) {
+        throw StreamInvalidArgumentException("Cannot spawn an empty task");
+    }
+    const auto handle = std::exchange(task.handle_, nullptr);
+    handle.promise().executor = this;
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex);
+        ++pimpl_->outstanding;
+        pimpl_->queue.push_back(handle);
+    }
+    pimpl_->ready.notify_one();
+}
+
+void StreamExecutor::wait()
+{
+    std::unique_lock<std::mutex> lock(pimpl_->mutex);
+    pimpl_->idle.wait(lock, [&] { return pimpl_->outstanding == 0; });
+    if (pimpl_->failure) {
+        std::rethrow_exception(std::exchange(pimpl_->failure, nullptr));
+    }
+}
+
+size_t StreamExecutor::thread_count() const noexcept
+{
+    return pimpl_->threads.size();
+}
+
+void StreamExecutor::task_finished(std::exception_ptr error) noexcept
+{
+    std::lock_guard<std::mutex> lock(pimpl_->mutex);
+    if (error && !pimpl_->failure) {
+        pimpl_->failure = std::move(error);
+    }
+    if (--pimpl_->outstanding == 0) {
+        pimpl_->idle.notify_all();
+    }
+}
+
+} // namespace dataproc
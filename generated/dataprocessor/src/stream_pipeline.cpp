@@ -0,0 +1,276 @@
+/**
+ * @file stream_pipeline.cpp
+ * @brief Implementation of the multi-stage stream pipeline
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "stream.h"
+#include "ring_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace dataproc {
+
+/* ========================================================================== */
+/* Private Types                                                             */
+/* ========================================================================== */
+
+namespace {
+    /**
+     * @brief What a packet travelling down the pipeline carries
+     */
+    enum class PacketKind : uint8_t {
+        Input,  ///< A whole call's input, cut into chunks by the first stage
+        Data,  ///< One chunk of output from the previous stage
+        End,  ///< The call's input is exhausted
+        Stop,  ///< The pipeline is shutting down
+    };
+
+    struct Packet {
+        PacketKind kind = PacketKind::Data;
+        std::span<const uint8_t> input;  ///< Set for PacketKind::Input
+        std::vector<uint8_t> bytes;  ///< Set for PacketKind::Data
+    };
+
+    using PacketRing = SpscRing<Packet>;
+}
+
+/* ========================================================================== */
+/* PIMPL Implementation                                                      */
+/* ========================================================================== */
+
+struct StreamPipeline::Impl {
+    struct Stage {
+        std::string name;
+        StreamStage transform;
+        std::unique_ptr<PacketRing> input;
+        std::vector<uint8_t> spare;  ///< Buffer for the stage's next output
+    };
+
+    size_t chunk_size;
+    size_t queue_depth;
+    std::vector<Stage> stages;
+    std::unique_ptr<PacketRing> output;  ///< Last stage to the caller
+    std::unique_ptr<SpscRing<std::vector<uint8_t>>> recycled;  ///< Caller back to the first stage
+    std::vector<std::thread> threads;
+
+    std::mutex call_mutex;  ///< Serializes process() calls
+    std::atomic<bool> failed{false};  ///< Set once the current call has failed; stages skip work
+    std::mutex error_mutex;
+    std::string error;
+
+    Impl(size_t chunk, size_t depth)
+        : chunk_size(chunk), queue_depth(depth) {}
+
+    ~Impl() {
+        stop();
+    }
+
+    void start() {
+        for (auto& stage : stages) {
+            stage.input = std::make_unique<PacketRing>(queue_depth);
+        }
+        output = std::make_unique<PacketRing>(queue_depth);
+        // Room for every buffer that can be in flight, so none are dropped
+        recycled = std::make_unique<SpscRing<std::vector<uint8_t>>>((stages.size() + 1) * (queue_depth + 1));
+
+        threads.reserve(stages.size());
+        try {
+            for (size_t i = 0; i < stages.size(); ++i) {
+                threads.emplace_back(&Impl::run_stage, this, i);
+            }
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    void stop() {
+        if (threads.empty()) {
+            return;
+        }
+        // Each stage forwards the packet before exiting
+        stages.front().input->push(Packet{PacketKind::Stop, {}, {}});
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+    }
+
+    void run_stage(size_t index) {
+        Stage& stage = stages[index];
+        PacketRing& next = index + 1 < stages.size() ? *stages[index + 1].input : *output;
+
+        for (;;) {
+            Packet packet = stage.input->pop();
+            switch (packet.kind) {
+            case PacketKind::Input:
+                for (size_t offset = 0; offset < packet.input.size(); offset += chunk_size) {
+                    if (stage.spare.capacity() == 0) {
+                        recycled->try_pop(stage.spare);
+                    }
+                    run_transform(stage, packet.input.subspan(offset, std::min(chunk_size, packet.input.size() - offset)), next);
+                }
+                next.push(Packet{PacketKind::End, {}, {}});
+                break;
+            case PacketKind::Data:
+                run_transform(stage, packet.bytes, next);
+                if (stage.spare.capacity() < packet.bytes.capacity()) {
+                    stage.spare = std::move(packet.bytes);
+                }
+                break;
+            case PacketKind::End:
+                next.push(std::move(packet));
+                break;
+            case PacketKind::Stop:
+                next.push(std::move(packet));
+                return;
+            }
+        }
+    }
+
+    void run_transform(Stage& stage, std::span<const uint8_t> chunk, PacketRing& next) {
+        Packet result{PacketKind::Data, {}, std::exchange(stage.spare, {})};
+        result.bytes.clear();
+
+        if (!failed.load(std::memory_order_relaxed)) {
+            try {
+                stage.transform(chunk, result.bytes);
+            } catch (const std::exception& e) {
+                record_failure(stage.name, e.what());
+            } catch (...) {
+                record_failure(stage.name, "unknown error");
+            }
+        }
+
+        if (result.bytes.empty() || failed.load(std::memory_order_relaxed)) {
+            stage.spare = std::move(result.bytes);
+            stage.spare.clear();
+            return;
+        }
+        next.push(std::move(result));
+    }
+
+    void record_failure(const std::string& stage_name, const std::string& what) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!failed.load(std::memory_order_relaxed)) {
+            error = "stage '" + stage_name + "' failed: " + what;
+            failed.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    void process(std::span<const uint8_t> input, const StreamSink& sink) {
+        std::lock_guard<std::mutex> lock(call_mutex);
+        if (stages.empty()) {
+            if (!input.empty()) {
+                sink(input);
+            }
+            return;
+        }
+        if (threads.empty()) {
+            start();
+        }
+
+        failed.store(false, std::memory_order_relaxed);
+        stages.front().input->push(Packet{PacketKind::Input, input, {}});
+
+        // Drain until the end marker even after a failure: the first stage
+        // may still be reading input, which has to stay valid until then
+        std::exception_ptr sink_error;
+        for (;;) {
+            Packet packet = output->pop();
+            if (packet.kind == PacketKind::End) {
+                break;
+            }
+            if (!failed.load(std::memory_order_relaxed)) {
+                try {
+                    sink(packet.bytes);
+                } catch (...) {
+                    sink_error = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            packet.bytes.clear();
+            recycled->try_push(packet.bytes);
+        }
+
+        if (sink_error) {
+            std::rethrow_exception(sink_error);
+        }
+        if (failed.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> error_lock(error_mutex);
+            throw StreamRuntimeException(error);
+        }
+    }
+};
+
+/* ========================================================================== */
+/* StreamPipeline Implementation                                             */
+/* ========================================================================== */
+
+StreamPipeline::StreamPipeline(size_t chunk_size, size_t queue_depth)
+    : pimpl_(std::make_unique<Impl>(chunk_size != 0 ? chunk_size : DEFAULT_PIPELINE_CHUNK_SIZE,
+                                    queue_depth != 0 ? queue_depth : DEFAULT_PIPELINE_QUEUE_DEPTH))
+{
+}
+
+StreamPipeline::~StreamPipeline() = default;
+
+StreamPipeline::StreamPipeline(StreamPipeline&& other) noexcept = default;
+
+StreamPipeline& StreamPipeline::operator=(StreamPipeline&& other) noexcept = default;
+
+StreamPipeline& StreamPipeline::add_stage(std::string name, StreamStage stage)
+{
+    if (!pimpl_) {
+        throw StreamRuntimeException("Invalid pipeline instance");
+    }
+    if (!stage) {
+        throw StreamInvalidArgumentException("stage '" + name + "' has no transform");
+    }
+
+    std::lock_guard<std::mutex> lock(pimpl_->call_mutex);
+    if (!pimpl_->threads.empty()) {
+        throw StreamRuntimeException("cannot add stage '" + name + "' to a running pipeline");
+    }
+    pimpl_->stages.push_back({std::move(name), std::move(stage), nullptr, {}});
+    return *this;
+}
+
+StreamPipeline& StreamPipeline::add_stage(const StreamConfig& config)
+{
+    // Shared so the stage stays copyable as a std::function
+    auto stream = std::make_shared<Stream>(config);
+    return add_stage("process_data", [stream](std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+        stream->process_data(input, output);
+    });
+}
+
+void StreamPipeline::process(std::span<const uint8_t> input, const StreamSink& sink)
+{
+    if (!pimpl_) {
+        throw StreamRuntimeException("Invalid pipeline instance");
+    }
+    pimpl_->process(input, sink);
+}
+
+void StreamPipeline::process(std::span<const uint8_t> input, std::vector<uint8_t>& output)
+{
+    process(input, [&output](std::span<const uint8_t> piece) {
+        output.insert(output.end(), piece.begin(), piece.end());
+    });
+}
+
+size_t StreamPipeline::stage_count() const noexcept
+{
+    return pimpl_ ? pimpl_->stages.size() : 0;
+}
+
+} // namespace dataproc
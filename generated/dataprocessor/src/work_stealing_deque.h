@@ -0,0 +1,117 @@
+/**
+ * @file work_stealing_deque.h
+ * @brief Chase-Lev work-stealing deque of task indices used by the worker pool
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#ifndef WORK_STEALING_DEQUE_
+#define WORK_STEALING_DEQUE_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace dataproc {
+
+/**
+ * @brief Per-worker queue of task indices that other workers can steal from
+ *
+ * The owner takes tasks from the bottom end without contention unless only
+ * one task is left; idle workers take from the top end with a single
+ * compare-and-swap (Chase and Lev, with the C11 orderings of Le et al.). The
+ * deque is filled while no worker is running, so it needs no growth and no
+ * concurrent push.
+ */
+class WorkStealingDeque {
+public:
+    /**
+     * @brief Outcome of a steal attempt
+     */
+    enum class Steal : uint8_t {
+        Taken,  ///< A task was taken
+        Empty,  ///< Nothing left to take
+        Lost,  ///< Another worker won the race; the deque may still hold tasks
+    };
+
+    WorkStealingDeque() = default;
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * @brief Replace the contents with [first, last), owner popping from first upward
+     *
+     * Must not run concurrently with pop() or steal(); publish the new
+     * contents to other threads with a lock or other release operation.
+     */
+    void assign(size_t first, size_t last) {
+        const size_t count = last - first;
+        if (count > capacity_) {
+            capacity_ = count;
+            tasks_ = std::make_unique<std::atomic<size_t>[]>(count);
+        }
+        // The owner pops the highest slot first, so store the range reversed
+        for (size_t i = 0; i < count; ++i) {
+            tasks_[i].store(last - 1 - i, std::memory_order_relaxed);
+        }
+        top_.store(0, std::memory_order_relaxed);
+        bottom_.store(static_cast<int64_t>(count), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Take the owner's next task (owner only)
+     * @return false once the deque is empty
+     */
+    bool pop(size_t& task) {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        task = tasks_[static_cast<size_t>(bottom)].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last task: race any thief for it
+            const bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Take the task furthest from the owner (any thread)
+     */
+    Steal steal(size_t& task) {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return Steal::Empty;
+        }
+        task = tasks_[static_cast<size_t>(top)].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return Steal::Lost;
+        }
+        return Steal::Taken;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> top_{0};  ///< Thieves' end
+    alignas(64) std::atomic<int64_t> bottom_{0};  ///< Owner's end
+    std::unique_ptr<std::atomic<size_t>[]> tasks_;
+    size_t capacity_ = 0;
+};
+
+} // namespace dataproc
+
+#endif /* WORK_STEALING_DEQUE_ */
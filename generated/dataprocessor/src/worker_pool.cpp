@@ -0,0 +1,152 @@
+/**
+ * @file worker_pool.cpp
+ * @brief Implementation of the persistent worker pool
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "worker_pool.h"
+
+namespace dataproc {
+
+WorkerPool::WorkerPool(size_t thread_count)
+    : deques_(std::make_unique<WorkStealingDeque[]>(thread_count + 1))
+{
+    threads_.reserve(thread_count);
+    try {
+        for (size_t i = 0; i < thread_count; ++i) {
+            threads_.emplace_back(&WorkerPool::worker_loop, this, i);
+        }
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        work_cv_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+        throw;
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkerPool::parallel_for(size_t count, const Task& task)
+{
+    if (count == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+
+    if (threads_.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i, threads_.size());
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        const size_t workers = concurrency();
+        for (size_t worker = 0; worker < workers; ++worker) {
+            deques_[worker].assign(count * worker / workers, count * (worker + 1) / workers);
+        }
+        cancelled_.store(false, std::memory_order_relaxed);
+        error_ = nullptr;
+        active_ = threads_.size();
+        ++generation_;
+    }
+    work_cv_.notify_all();
+
+    drain(threads_.size());
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return active_ == 0; });
+    task_ = nullptr;
+
+    if (error_) {
+        std::exception_ptr error = std::move(error_);
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkerPool::worker_loop(size_t worker)
+{
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait(lock, [this, seen] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        drain(worker);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--active_ == 0) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+void WorkerPool::drain(size_t worker)
+{
+    size_t index;
+    while (deques_[worker].pop(index) || steal(worker, index)) {
+        if (cancelled_.load(std::memory_order_relaxed)) {
+            continue;  // Empty the deques without running anything
+        }
+        try {
+            (*task_)(index, worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+            cancelled_.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool WorkerPool::steal(size_t worker, size_t& task)
+{
+    const size_t workers = concurrency();
+    for (;;) {
+        bool contended = false;
+        for (size_t offset = 1; offset < workers; ++offset) {
+            switch (deques_[(worker + offset) % workers].steal(task)) {
+            case WorkStealingDeque::Steal::Taken:
+                return true;
+            case WorkStealingDeque::Steal::Lost:
+                contended = true;
+                break;
+            case WorkStealingDeque::Steal::Empty:
+                break;
+            }
+        }
+        // Nothing is added during a job, so every deque empty means done
+        if (!contended) {
+            return false;
+        }
+    }
+}
+
+} // namespace dataproc
@@ -0,0 +1,98 @@
+/**
+ * @file worker_pool.h
+ * @brief Persistent worker pool used by the stream module
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#ifndef WORKER_POOL_
+#define WORKER_POOL_
+
+#include "work_stealing_deque.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dataproc {
+
+/**
+ * @brief Fixed set of threads that execute indexed parallel loops
+ *
+ * Threads are started once and parked between jobs, so submitting work does
+ * not pay for thread creation. The submitting thread takes part in every job
+ * as the last worker, which means a pool constructed with N background
+ * threads runs N + 1 tasks concurrently.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Task signature: (task index, worker index)
+     *
+     * The worker index is stable for the duration of a task and lies in
+     * [0, concurrency()), so it can address per-worker state without locking.
+     */
+    using Task = std::function<void(size_t, size_t)>;
+
+    /**
+     * @brief Start @p thread_count background threads
+     */
+    explicit WorkerPool(size_t thread_count);
+
+    /**
+     * @brief Stop and join all background threads
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Number of tasks that can run at once (threads plus the caller)
+     */
+    size_t concurrency() const noexcept { return threads_.size() + 1; }
+
+    /**
+     * @brief Run @p task for every index in [0, count) and wait for completion
+     *
+     * Each worker starts on its own contiguous share of the indices, held in
+     * a work-stealing deque; a worker that runs out steals from the far end
+     * of another's share, so a few expensive tasks cannot leave the rest of
+     * the pool idle. Concurrent callers are serialized. If any task throws,
+     * remaining unclaimed indices are skipped and the first exception is
+     * rethrown here.
+     */
+    void parallel_for(size_t count, const Task& task);
+
+private:
+    void worker_loop(size_t worker);
+    void drain(size_t worker);
+    bool steal(size_t worker, size_t& task);
+
+    std::vector<std::thread> threads_;
+    std::mutex submit_mutex_;
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_ = 0;
+    size_t active_ = 0;
+    bool stopping_ = false;
+
+    const Task* task_ = nullptr;
+    std::unique_ptr<WorkStealingDeque[]> deques_;  ///< One per worker, the caller's last
+    std::atomic<bool> cancelled_{false};  ///< Set when a task throws
+    std::exception_ptr error_;
+};
+
+} // namespace dataproc
+
+#endif /* WORKER_POOL_ */
@@ -0,0 +1,196 @@
+/**
+ * @file zscore_kernel.cpp
+ * @brief Implementation of the vectorized anomaly detection passes
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include "zscore_kernel.h"
+
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define ZSCORE_SIMD_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace dataproc {
+namespace zscore {
+
+/* ========================================================================== */
+/* Portable Kernel                                                           */
+/* ========================================================================== */
+
+namespace {
+    constexpr double LARGEST_FINITE = std::numeric_limits<double>::max();
+
+    size_t select_outliers_portable(const double* data, size_t size, double center, double cutoff,
+                                    size_t base, size_t* out) noexcept
+    {
+        // Branch-free: the slot after the last selected index is always
+        // free, because no more indices than points have been written
+        size_t count = 0;
+        for (size_t i = 0; i < size; ++i) {
+            const double deviation = std::abs(data[i] - center);
+            out[count] = base + i;
+            count += (deviation > cutoff && deviation <= LARGEST_FINITE) ? 1 : 0;
+        }
+        return count;
+    }
+}
+
+/* ========================================================================== */
+/* SIMD Kernels                                                              */
+/* ========================================================================== */
+
+#if defined(ZSCORE_SIMD_DISPATCH)
+namespace {
+    /**
+     * @brief vpermd selectors that move the selected 64-bit lanes to the front
+     *
+     * AVX2 has no compress instruction, so the 4-bit comparison mask picks
+     * one of 16 permutations instead. Lanes past the selected ones are
+     * don't-care; they are overwritten by the next store.
+     */
+    struct CompressTable {
+        uint32_t lanes[16][8];
+    };
+
+    constexpr CompressTable make_compress_table()
+    {
+        CompressTable table{};
+        for (uint32_t mask = 0; mask < 16; ++mask) {
+            uint32_t selected = 0;
+            for (uint32_t lane = 0; lane < 4; ++lane) {
+                if ((mask >> lane) & 1) {
+                    table.lanes[mask][2 * selected] = 2 * lane;
+                    table.lanes[mask][2 * selected + 1] = 2 * lane + 1;
+                    ++selected;
+                }
+            }
+        }
+        return table;
+    }
+
+    constexpr CompressTable COMPRESS_TABLE = make_compress_table();
+
+    __attribute__((target("avx2")))
+    size_t select_outliers_avx2(const double* data, size_t size, double center, double cutoff,
+                                size_t base, size_t* out) noexcept
+    {
+        const __m256d centers = _mm256_set1_pd(center);
+        const __m256d cutoffs = _mm256_set1_pd(cutoff);
+        const __m256d largest = _mm256_set1_pd(LARGEST_FINITE);
+        const __m256d sign = _mm256_set1_pd(-0.0);
+        const __m256i step = _mm256_set1_epi64x(4);
+        const auto first = static_cast<long long>(base);
+        __m256i indices = _mm256_setr_epi64x(first, first + 1, first + 2, first + 3);
+
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            const __m256d deviation = _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(data + i), centers));
+            const __m256d selected = _mm256_and_pd(_mm256_cmp_pd(deviation, cutoffs, _CMP_GT_OQ),
+                                                   _mm256_cmp_pd(deviation, largest, _CMP_LE_OQ));
+            const auto mask = static_cast<unsigned>(_mm256_movemask_pd(selected));
+            if (mask != 0) {
+                const __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(COMPRESS_TABLE.lanes[mask]));
+                // A full vector store is safe: at most i indices precede it
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + count), _mm256_permutevar8x32_epi32(indices, lanes));
+                count += static_cast<size_t>(std::popcount(mask));
+            }
+            indices = _mm256_add_epi64(indices, step);
+        }
+        return count + select_outliers_portable(data + i, size - i, center, cutoff, base + i, out + count);
+    }
+
+    __attribute__((target("avx512f")))
+    size_t select_outliers_avx512(const double* data, size_t size, double center, double cutoff,
+                                  size_t base, size_t* out) noexcept
+    {
+        const __m512d centers = _mm512_set1_pd(center);
+        const __m512d cutoffs = _mm512_set1_pd(cutoff);
+        const __m512d largest = _mm512_set1_pd(LARGEST_FINITE);
+        const __m512i step = _mm512_set1_epi64(8);
+        __m512i indices = _mm512_add_epi64(_mm512_set1_epi64(static_cast<long long>(base)),
+                                           _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0));
+
+        size_t count = 0;
+        for (size_t i = 0; i < size; i += 8) {
+            // The tail is a masked load, so there is no scalar remainder loop
+            const size_t remaining = size - i;
+            const auto live = remaining >= 8 ? __mmask8{0xFF} : static_cast<__mmask8>((1u << remaining) - 1);
+            const __m512d deviation = _mm512_abs_pd(_mm512_sub_pd(_mm512_maskz_loadu_pd(live, data + i), centers));
+            const __mmask8 finite = _mm512_mask_cmp_pd_mask(live, deviation, largest, _CMP_LE_OQ);
+            const __mmask8 selected = _mm512_mask_cmp_pd_mask(finite, deviation, cutoffs, _CMP_GT_OQ);
+            if (selected != 0) {
+                _mm512_mask_compressstoreu_epi64(out + count, selected, indices);
+                count += static_cast<size_t>(std::popcount(static_cast<unsigned>(selected)));
+            }
+            indices = _mm512_add_epi64(indices, step);
+        }
+        return count;
+    }
+}
+#endif
+
+/* ========================================================================== */
+/* Dispatch                                                                  */
+/* ========================================================================== */
+
+namespace {
+    Kernel detect_best_kernel() noexcept
+    {
+#if defined(ZSCORE_SIMD_DISPATCH)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return Kernel::Avx512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return Kernel::Avx2;
+        }
+#endif
+        return Kernel::Portable;
+    }
+}
+
+Kernel best_kernel() noexcept
+{
+    static const Kernel kernel = detect_best_kernel();
+    return kernel;
+}
+
+size_t select_outliers(const double* data, size_t size, double center, double cutoff,
+                       size_t base, size_t* out) noexcept
+{
+    return select_outliers(best_kernel(), data, size, center, cutoff, base, out);
+}
+
+size_t select_outliers(Kernel kernel, const double* data, size_t size, double center, double cutoff,
+                       size_t base, size_t* out) noexcept
+{
+    switch (kernel) {
+#if defined(ZSCORE_SIMD_DISPATCH)
+        case Kernel::Avx512:
+            return select_outliers_avx512(data, size, center, cutoff, base, out);
+        case Kernel::Avx2:
+            return select_outliers_avx2(data, size, center, cutoff, base, out);
+#endif
+        default:
+            return select_outliers_portable(data, size, center, cutoff, base, out);
+    }
+}
+
+void absolute_deviations(double* values, size_t size, double center) noexcept
+{
+    // Straight-line loop the compiler vectorizes at the baseline ISA
+    for (size_t i = 0; i < size; ++i) {
+        values[i] = std::abs(values[i] - center);
+    }
+}
+
+} // namespace zscore
+} // namespace dataproc
@@ -0,0 +1,65 @@
+/**
+ * @file zscore_kernel.h
+ * @brief Vectorized passes behind Analyzer::detect_anomalies
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ *
+ * The median and MAD of a batch are found by selection, which does not
+ * vectorize; everything that touches every point once does. The outlier
+ * scan compares |x - center| against a cutoff and writes the indices that
+ * pass with a compress-store: AVX-512 has the instruction, AVX2 emulates it
+ * with a lane permutation table. The widest kernel the CPU supports is
+ * chosen at first use; a portable one gives the same results everywhere.
+ */
+
+#ifndef ZSCORE_KERNEL_
+#define ZSCORE_KERNEL_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dataproc {
+namespace zscore {
+
+/**
+ * @brief Instruction set an outlier scan runs on
+ */
+enum class Kernel : uint8_t {
+    Portable = 0,
+    Avx2 = 1,
+    Avx512 = 2
+};
+
+/**
+ * @brief Widest kernel this CPU runs; every narrower one also runs
+ */
+Kernel best_kernel() noexcept;
+
+/**
+ * @brief Indices of the points far from @p center
+ *
+ * Writes base + i for every i with |data[i] - center| > @p cutoff, in
+ * increasing order. Non-finite points are never selected.
+ *
+ * @param out Room for @p size indices
+ * @return size_t Indices written
+ */
+size_t select_outliers(const double* data, size_t size, double center, double cutoff,
+                       size_t base, size_t* out) noexcept;
+
+/**
+ * @brief select_outliers() on a specific kernel, which must not be wider than best_kernel()
+ */
+size_t select_outliers(Kernel kernel, const double* data, size_t size, double center, double cutoff,
+                       size_t base, size_t* out) noexcept;
+
+/**
+ * @brief Replace each value with its distance from @p center
+ */
+void absolute_deviations(double* values, size_t size, double center) noexcept;
+
+} // namespace zscore
+} // namespace dataproc
+
+#endif /* ZSCORE_KERNEL_ */
@@ -9,8 +9,16 @@
 #include <gtest/gtest.h>
 #include "analyzer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <span>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <stdexcept>
 
@@ -108,12 +116,8 @@ TEST_F(AnalyzerTest, AnalyzeTimeSeriesInvalidParameters) {
 
 TEST_F(AnalyzerTest, AnalyzeTimeSeriesOnInvalidInstance) {
     /* Test calling method on invalid instance */
-    instance_.reset(); // Make instance invalid
-    instance_ = std::make_unique<Analyzer>();
-    
-    /* Simulate invalid state */
-    Analyzer invalid_instance(std::move(*instance_));
-    *instance_ = std::move(invalid_instance); // Now instance_ should be invalid
+    Analyzer moved_to(std::move(*instance_)); // instance_ is left moved-from
+    ASSERT_FALSE(instance_->is_valid());
     
     std::vector<double> data{};
     std::vector<uint64_t> timestamps{};
@@ -149,12 +153,8 @@ TEST_F(AnalyzerTest, DetectAnomaliesInvalidParameters) {
 
 TEST_F(AnalyzerTest, DetectAnomaliesOnInvalidInstance) {
     /* Test calling method on invalid instance */
-    instance_.reset(); // Make instance invalid
-    instance_ = std::make_unique<Analyzer>();
-    
-    /* Simulate invalid state */
-    Analyzer invalid_instance(std::move(*instance_));
-    *instance_ = std::move(invalid_instance); // Now instance_ should be invalid
+    Analyzer moved_to(std::move(*instance_)); // instance_ is left moved-from
+    ASSERT_FALSE(instance_->is_valid());
     
     std::vector<double> data{};
     double sensitivity{};
@@ -188,12 +188,8 @@ TEST_F(AnalyzerTest, ComputeCorrelationMatrixInvalidParameters) {
 
 TEST_F(AnalyzerTest, ComputeCorrelationMatrixOnInvalidInstance) {
     /* Test calling method on invalid instance */
-    instance_.reset(); // Make instance invalid
-    instance_ = std::make_unique<Analyzer>();
-    
-    /* Simulate invalid state */
-    Analyzer invalid_instance(std::move(*instance_));
-    *instance_ = std::move(invalid_instance); // Now instance_ should be invalid
+    Analyzer moved_to(std::move(*instance_)); // instance_ is left moved-from
+    ASSERT_FALSE(instance_->is_valid());
     
     std::vector<std::vector<double>> data{};
     
@@ -250,16 +246,17 @@ TEST(AnalyzerFreeFunctionTest, GetBuildInfo) {
 /* ========================================================================== */
 
 TEST(AnalyzerEnumTest, PatternTypeToString) {
-    std::string str = to_string(PatternType::Periodic);
+    std::string str;
+    str = to_string(PatternType::Periodic);
     EXPECT_FALSE(str.empty());
     EXPECT_EQ(str, "Periodic");
-    std::string str = to_string(PatternType::Trending);
+    str = to_string(PatternType::Trending);
     EXPECT_FALSE(str.empty());
     EXPECT_EQ(str, "Trending");
-    std::string str = to_string(PatternType::Anomaly);
+    str = to_string(PatternType::Anomaly);
     EXPECT_FALSE(str.empty());
     EXPECT_EQ(str, "Anomaly");
-    std::string str = to_string(PatternType::Cluster);
+    str = to_string(PatternType::Cluster);
     EXPECT_FALSE(str.empty());
     EXPECT_EQ(str, "Cluster");
 }
@@ -313,6 +310,373 @@ TEST(AnalyzerStructTest, AnalysisResultMoveSemantics) {
 }
 
 
+/* ========================================================================== */
+/* Batch Anomaly Detection Tests                                             */
+/* ========================================================================== */
+
+TEST_F(AnalyzerTest, DetectAnomaliesFindsSpikes) {
+    std::vector<double> data;
+    for (int i = 0; i < 1001; ++i) {
+        data.push_back(50.0 + ((i * 7919) % 101 - 50) * 0.02);
+    }
+    data[17] = 90.0;
+    data[500] = 10.0;
+    data[999] = 58.0;
+
+    /* Robust statistics are not dragged by the spikes themselves */
+    EXPECT_EQ(instance_->detect_anomalies(data, 0.999), (std::vector<size_t>{17, 500, 999}));
+
+    /* A slice needs no copy; indices are relative to it */
+    EXPECT_EQ(instance_->detect_anomalies(std::span<const double>(data).subspan(400), 0.999),
+              (std::vector<size_t>{100, 599}));
+
+    /* A lower confidence calls more points anomalous */
+    const auto loose = instance_->detect_anomalies(data, 0.5);
+    EXPECT_GT(loose.size(), 3u);
+    EXPECT_TRUE(std::is_sorted(loose.begin(), loose.end()));
+}
+
+TEST_F(AnalyzerTest, DetectAnomaliesEdgeCases) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_TRUE(instance_->detect_anomalies(std::vector<double>{}, 0.95).empty());
+    EXPECT_TRUE(instance_->detect_anomalies({nan, nan}, 0.95).empty());
+    EXPECT_TRUE(instance_->detect_anomalies({3.0, 3.0, 3.0}, 0.95).empty());
+
+    /* Over half the points equal: the MAD is 0, the mean deviation is used instead */
+    std::vector<double> flat(100, 1.0);
+    flat[10] = 5.0;
+    flat[20] = nan;
+    flat[30] = -100.0;
+    EXPECT_EQ(instance_->detect_anomalies(flat, 0.95), (std::vector<size_t>{10, 30}));
+
+    EXPECT_EQ(instance_->detect_anomalies(flat, 0.0), (std::vector<size_t>{10, 30}));
+    EXPECT_THROW(instance_->detect_anomalies(flat, -0.1), AnalyzerInvalidArgumentException);
+    EXPECT_THROW(instance_->detect_anomalies(flat, 1.0), AnalyzerInvalidArgumentException);
+    EXPECT_THROW(instance_->detect_anomalies(flat, nan), AnalyzerInvalidArgumentException);
+}
+
+/* ========================================================================== */
+/* Matrix Tests                                                              */
+/* ========================================================================== */
+
+TEST(MatrixTest, ColumnMajorAlignedStorage) {
+    Matrix matrix(5, 3);
+    EXPECT_EQ(matrix.rows(), 5u);
+    EXPECT_EQ(matrix.cols(), 3u);
+    EXPECT_EQ(matrix.stride(), Matrix::ALIGNMENT / sizeof(double));
+    for (size_t c = 0; c < matrix.cols(); ++c) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(matrix.column(c).data()) % Matrix::ALIGNMENT, 0u);
+        EXPECT_EQ(matrix.column(c).size(), 5u);
+    }
+
+    matrix(4, 2) = 7.0;
+    EXPECT_EQ(matrix.data()[2 * matrix.stride() + 4], 7.0);
+    EXPECT_EQ(matrix(0, 0), 0.0);
+
+    /* Copies are deep; moves leave an empty matrix behind */
+    Matrix copy = matrix;
+    copy(4, 2) = 1.0;
+    EXPECT_EQ(matrix(4, 2), 7.0);
+    Matrix moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved(4, 2), 1.0);
+    EXPECT_TRUE(Matrix().empty());
+    EXPECT_EQ(Matrix(0, 4).data(), nullptr);
+}
+
+TEST(MatrixTest, ViewsBlocksAndConversions) {
+    const std::vector<std::vector<double>> columns = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}};
+    const Matrix matrix = Matrix::from_columns(columns);
+    EXPECT_EQ(matrix.to_columns(), columns);
+
+    const MatrixView view = matrix;
+    EXPECT_EQ(view(2, 3), 12.0);
+    const MatrixView block = view.block(1, 1, 2, 2);
+    EXPECT_EQ(block.stride(), matrix.stride());
+    EXPECT_EQ(block(0, 0), 5.0);
+    EXPECT_EQ(block(1, 1), 9.0);
+    EXPECT_EQ(std::vector<double>(block.column(1).begin(), block.column(1).end()), (std::vector<double>{8, 9}));
+    EXPECT_EQ(Matrix(block).to_columns(), (std::vector<std::vector<double>>{{5, 6}, {8, 9}}));
+
+    /* A caller's buffer with its own stride */
+    const double packed[] = {1, 2, -1, 3, 4, -1};
+    const MatrixView strided(packed, 2, 2, 3);
+    EXPECT_EQ(strided(1, 1), 4.0);
+
+    EXPECT_THROW(view.block(2, 0, 2, 1), AnalyzerInvalidArgumentException);
+    EXPECT_THROW(view.block(0, 3, 1, 2), AnalyzerInvalidArgumentException);
+    EXPECT_THROW(MatrixView(packed, 3, 2, 2), AnalyzerInvalidArgumentException);
+    EXPECT_THROW(MatrixView(nullptr, 1, 1), AnalyzerInvalidArgumentException);
+    EXPECT_THROW(Matrix::from_columns({{1.0}, {1.0, 2.0}}), AnalyzerInvalidArgumentException);
+}
+
+/* ========================================================================== */
+/* Correlation Matrix Tests                                                  */
+/* ========================================================================== */
+
+namespace {
+    /**
+     * @brief Variables mixing a few shared factors, so correlations span (-1, 1)
+     */
+    std::vector<std::vector<double>> correlated_variables(size_t variables, size_t samples)
+    {
+        std::vector<std::vector<double>> factors(3, std::vector<double>(samples));
+        uint32_t state = 2463534242u;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return static_cast<double>(state) / 4294967296.0 - 0.5;
+        };
+        for (auto& factor : factors) {
+            for (double& value : factor) {
+                value = next();
+            }
+        }
+        std::vector<std::vector<double>> data(variables, std::vector<double>(samples));
+        for (size_t v = 0; v < variables; ++v) {
+            const double weight = static_cast<double>(v % 7) - 3.0;
+            for (size_t s = 0; s < samples; ++s) {
+                data[v][s] = 100.0 + weight * factors[v % 3][s] + 0.5 * next();
+            }
+        }
+        return data;
+    }
+
+    double pearson(const std::vector<double>& x, const std::vector<double>& y)
+    {
+        double mean_x = 0.0;
+        double mean_y = 0.0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            mean_x += x[i];
+            mean_y += y[i];
+        }
+        mean_x /= static_cast<double>(x.size());
+        mean_y /= static_cast<double>(y.size());
+        double xy = 0.0;
+        double xx = 0.0;
+        double yy = 0.0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            xy += (x[i] - mean_x) * (y[i] - mean_y);
+            xx += (x[i] - mean_x) * (x[i] - mean_x);
+            yy += (y[i] - mean_y) * (y[i] - mean_y);
+        }
+        return xy / std::sqrt(xx * yy);
+    }
+}
+
+TEST_F(AnalyzerTest, CorrelationMatrixMatchesPearson) {
+    /* Not a multiple of the tile width, several tiles, rows not a multiple of the vector width */
+    const auto data = correlated_variables(101, 1003);
+    const auto matrix = instance_->compute_correlation_matrix(data);
+    ASSERT_EQ(matrix.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        ASSERT_EQ(matrix[i].size(), data.size());
+        EXPECT_EQ(matrix[i][i], 1.0);
+        for (size_t j = 0; j < data.size(); ++j) {
+            ASSERT_NEAR(matrix[i][j], pearson(data[i], data[j]), 1e-12) << i << "," << j;
+            ASSERT_EQ(matrix[i][j], matrix[j][i]);
+        }
+    }
+}
+
+TEST_F(AnalyzerTest, CorrelationMatrixEdgeCases) {
+    EXPECT_TRUE(instance_->compute_correlation_matrix(std::vector<std::vector<double>>{}).empty());
+    EXPECT_TRUE(instance_->compute_correlation_matrix(MatrixView()).empty());
+
+    /* Exact (anti)correlation; a constant or non-finite variable has none */
+    const std::vector<std::vector<double>> data = {
+        {1.0, 2.0, 3.0, 4.0},
+        {-2.0, -4.0, -6.0, -8.0},
+        {5.0, 5.0, 5.0, 5.0},
+        {1.0, std::numeric_limits<double>::quiet_NaN(), 0.0, 2.0}};
+    const auto matrix = instance_->compute_correlation_matrix(data);
+    EXPECT_EQ(matrix[0][1], -1.0);
+    EXPECT_EQ(matrix[1][0], -1.0);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_TRUE(std::isnan(matrix[2][i]));
+        EXPECT_TRUE(std::isnan(matrix[i][3]));
+    }
+
+    EXPECT_THROW(instance_->compute_correlation_matrix({{1.0, 2.0}, {1.0}}), AnalyzerInvalidArgumentException);
+}
+
+TEST_F(AnalyzerTest, CorrelationMatrixOfMatrixAndBlocks) {
+    const auto data = correlated_variables(60, 500);
+    const Matrix samples = Matrix::from_columns(data);
+    const auto expected = instance_->compute_correlation_matrix(data);
+
+    const Matrix matrix = instance_->compute_correlation_matrix(samples);
+    ASSERT_EQ(matrix.rows(), 60u);
+    ASSERT_EQ(matrix.cols(), 60u);
+    EXPECT_EQ(matrix.to_columns(), expected);
+
+    /* A strided block correlates a subset of variables over a subset of samples */
+    const Matrix block = instance_->compute_correlation_matrix(samples.view().block(100, 10, 300, 20));
+    ASSERT_EQ(block.cols(), 20u);
+    for (size_t i = 0; i < 20; ++i) {
+        for (size_t j = 0; j < 20; ++j) {
+            const std::vector<double> x(data[10 + i].begin() + 100, data[10 + i].begin() + 400);
+            const std::vector<double> y(data[10 + j].begin() + 100, data[10 + j].begin() + 400);
+            ASSERT_NEAR(block(i, j), pearson(x, y), 1e-12) << i << "," << j;
+        }
+    }
+}
+
+TEST_F(AnalyzerTest, DISABLED_CorrelationMatrixThroughput) {
+    /* A 480-variable matrix over 20000 samples; disabled in the unit suite */
+    const auto data = correlated_variables(480, 20000);
+    const auto start = std::chrono::steady_clock::now();
+    const auto matrix = instance_->compute_correlation_matrix(data);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_NEAR(matrix[0][3], pearson(data[0], data[3]), 1e-12);
+
+    const double pairs_per_second = 480.0 * 481.0 / 2.0 * 20000.0 / elapsed.count();
+    RecordProperty("sample_pairs_per_second", std::to_string(pairs_per_second));
+}
+
+/* ========================================================================== */
+/* Online Anomaly Detector Tests                                             */
+/* ========================================================================== */
+
+TEST(OnlineAnomalyDetectorTest, WelfordMatchesBatchStatistics) {
+    OnlineAnomalyDetector detector({.model = AnomalyModel::Welford, .threshold = 3.0});
+    const std::vector<double> values = {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0};
+    std::vector<size_t> anomalies;
+    EXPECT_EQ(detector.update(1, values, anomalies), 0u);
+    EXPECT_TRUE(anomalies.empty());
+
+    /* Updating series 1 grew the set; series 0 is still untouched */
+    EXPECT_EQ(detector.series_count(), 2u);
+    EXPECT_EQ(detector.count(0), 0u);
+    EXPECT_EQ(detector.count(1), values.size());
+    EXPECT_DOUBLE_EQ(detector.mean(1), 5.0);
+    EXPECT_DOUBLE_EQ(detector.stddev(1), std::sqrt(32.0 / 7.0));
+
+    detector.reset(1);
+    EXPECT_EQ(detector.count(1), 0u);
+    EXPECT_EQ(detector.mean(1), 0.0);
+    EXPECT_EQ(to_string(AnomalyModel::Welford), "Welford");
+    EXPECT_EQ(to_string(AnomalyModel::Ewma), "Ewma");
+}
+
+TEST(OnlineAnomalyDetectorTest, FlagsSpikesAfterWarmup) {
+    for (const AnomalyModel model : {AnomalyModel::Welford, AnomalyModel::Ewma}) {
+        OnlineAnomalyDetector detector({.model = model, .threshold = 4.0, .alpha = 0.1, .warmup = 20,
+                                        .absorb_anomalies = false});
+        std::vector<double> values;
+        for (int i = 0; i < 200; ++i) {
+            values.push_back(10.0 + ((i * 7) % 5) * 0.1);
+        }
+        values[5] = 100.0;   /* inside the warmup, so not flagged */
+        values[120] = 100.0;
+        values[121] = -80.0;
+
+        std::vector<size_t> anomalies;
+        EXPECT_EQ(detector.update(0, values, anomalies), 2u) << to_string(model);
+        EXPECT_EQ(anomalies, (std::vector<size_t>{120, 121})) << to_string(model);
+
+        /* Spikes were not absorbed, so the next one is judged the same way */
+        const AnomalyVerdict verdict = detector.update(0, 100.0);
+        EXPECT_TRUE(verdict.anomaly);
+        EXPECT_GT(verdict.score, 4.0);
+        EXPECT_FALSE(detector.update(0, 10.2).anomaly);
+        EXPECT_EQ(detector.count(0), values.size() - 2 + 1);
+    }
+}
+
+TEST(OnlineAnomalyDetectorTest, TicksMatchPerSeriesUpdates) {
+    const size_t series_count = 1000;
+    const OnlineAnomalyConfig config{.model = AnomalyModel::Ewma, .threshold = 3.0, .warmup = 10};
+    OnlineAnomalyDetector by_tick(config, series_count);
+    OnlineAnomalyDetector by_series(config);
+
+    std::vector<std::vector<double>> history(series_count);
+    std::vector<std::pair<size_t, size_t>> tick_anomalies;
+    std::vector<double> tick(series_count);
+    std::vector<size_t> flagged;
+    uint32_t state = 12345;
+    for (size_t t = 0; t < 100; ++t) {
+        for (size_t s = 0; s < series_count; ++s) {
+            state = state * 1664525u + 1013904223u;
+            tick[s] = static_cast<double>(s) + static_cast<double>(state >> 16) / 65536.0;
+            if ((state >> 8) % 997 == 0) {
+                tick[s] += 50.0;
+            }
+            history[s].push_back(tick[s]);
+        }
+        flagged.clear();
+        by_tick.update_all(tick, flagged);
+        for (const size_t s : flagged) {
+            tick_anomalies.emplace_back(s, t);
+        }
+    }
+    EXPECT_FALSE(tick_anomalies.empty());
+
+    std::vector<std::pair<size_t, size_t>> series_anomalies;
+    for (size_t s = 0; s < series_count; ++s) {
+        flagged.clear();
+        by_series.update(s, history[s], flagged);
+        for (const size_t t : flagged) {
+            series_anomalies.emplace_back(s, t);
+        }
+        EXPECT_EQ(by_series.mean(s), by_tick.mean(s));
+        EXPECT_EQ(by_series.stddev(s), by_tick.stddev(s));
+    }
+    std::sort(tick_anomalies.begin(), tick_anomalies.end());
+    EXPECT_EQ(series_anomalies, tick_anomalies);
+}
+
+TEST(OnlineAnomalyDetectorTest, SkipsNonFiniteAndRejectsBadConfig) {
+    OnlineAnomalyDetector detector({.model = AnomalyModel::Welford, .warmup = 2}, 3);
+    const std::vector<double> tick = {1.0, std::numeric_limits<double>::quiet_NaN(),
+                                      std::numeric_limits<double>::infinity()};
+    std::vector<size_t> anomalies;
+    EXPECT_EQ(detector.update_all(tick, anomalies), 0u);
+    EXPECT_EQ(detector.count(0), 1u);
+    EXPECT_EQ(detector.count(1), 0u);
+    EXPECT_EQ(detector.count(2), 0u);
+    EXPECT_FALSE(detector.update(5, std::numeric_limits<double>::quiet_NaN()).anomaly);
+    EXPECT_EQ(detector.series_count(), 3u);
+
+    /* A flat series flags any change once warmed up */
+    detector.update(0, 1.0);
+    const AnomalyVerdict verdict = detector.update(0, 1.5);
+    EXPECT_TRUE(verdict.anomaly);
+    EXPECT_TRUE(std::isinf(verdict.score));
+
+    EXPECT_THROW(OnlineAnomalyDetector({.threshold = 0.0}), AnalyzerInvalidArgumentException);
+    EXPECT_THROW(OnlineAnomalyDetector({.threshold = std::numeric_limits<double>::infinity()}),
+                 AnalyzerInvalidArgumentException);
+    EXPECT_THROW(OnlineAnomalyDetector({.model = AnomalyModel::Ewma, .alpha = 0.0}), AnalyzerInvalidArgumentException);
+    EXPECT_THROW(OnlineAnomalyDetector({.model = AnomalyModel::Ewma, .alpha = 1.5}), AnalyzerInvalidArgumentException);
+    EXPECT_NO_THROW(OnlineAnomalyDetector({.model = AnomalyModel::Welford, .alpha = 0.0}));
+}
+
+TEST(OnlineAnomalyDetectorTest, DISABLED_TickThroughput) {
+    /* 50 ticks across 200k series; disabled in the unit suite */
+    const size_t series_count = 200000;
+    OnlineAnomalyDetector detector({.model = AnomalyModel::Ewma}, series_count);
+    std::vector<double> tick(series_count);
+    for (size_t s = 0; s < series_count; ++s) {
+        tick[s] = static_cast<double>(s % 100);
+    }
+
+    std::vector<size_t> anomalies;
+    const int ticks = 50;
+    const auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        anomalies.clear();
+        tick[static_cast<size_t>(t) % series_count] += 0.5;
+        detector.update_all(tick, anomalies);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(detector.count(series_count - 1), static_cast<uint64_t>(ticks));
+
+    const double updates_per_second = ticks * static_cast<double>(series_count) / elapsed.count();
+    RecordProperty("updates_per_second", std::to_string(updates_per_second));
+}
+
 /* ========================================================================== */
 /* Performance Tests                                                         */
 /* ========================================================================== */
@@ -365,12 +729,3 @@ TEST(AnalyzerThreadSafetyTest, ConcurrentInstantiation) {
     
     EXPECT_EQ(success_count.load(), thread_count * instances_per_thread);
 }
-
-/* ========================================================================== */
-/* Main Function                                                             */
-/* ========================================================================== */
-
-int main(int argc, char** argv) {
-    ::testing::InitGoogleTest(&argc, argv);
-    return RUN_ALL_TESTS();
-}
\ No newline at end of file
@@ -0,0 +1,72 @@
+/**
+ * @file test_buffer_pool.cpp
+ * @brief Unit tests for the bounded buffer pool using Google Test framework
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include <gtest/gtest.h>
+#include "buffer_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace dataproc;
+
+TEST(BufferPoolTest, LeasesDistinctBuffersUpToCapacity) {
+    BufferPool pool(4096, 3);
+    EXPECT_EQ(pool.buffer_size(), 4096u);
+    EXPECT_EQ(pool.capacity(), 3u);
+
+    std::vector<BufferPool::Lease> leases;
+    for (int i = 0; i < 3; ++i) {
+        leases.push_back(pool.try_acquire());
+        ASSERT_TRUE(leases.back());
+        EXPECT_EQ(leases.back().size(), 4096u);
+    }
+    EXPECT_NE(leases[0].data(), leases[1].data());
+    EXPECT_NE(leases[1].data(), leases[2].data());
+    EXPECT_EQ(pool.available(), 0u);
+
+    /* Exhausted: the caller is told instead of the pool growing */
+    EXPECT_FALSE(pool.try_acquire());
+
+    leases.pop_back();
+    EXPECT_EQ(pool.available(), 1u);
+    EXPECT_TRUE(pool.try_acquire());
+}
+
+TEST(BufferPoolTest, LeaseReleasesOnMoveAndReset) {
+    BufferPool pool(64, 1);
+    BufferPool::Lease first = pool.acquire();
+    BufferPool::Lease second = std::move(first);
+    EXPECT_FALSE(first);
+    EXPECT_TRUE(second);
+    EXPECT_EQ(pool.available(), 0u);
+
+    second.release();
+    EXPECT_FALSE(second);
+    EXPECT_EQ(pool.available(), 1u);
+}
+
+TEST(BufferPoolTest, AcquireBlocksUntilBufferReturned) {
+    BufferPool pool(64, 1);
+    BufferPool::Lease held = pool.acquire();
+
+    std::atomic<bool> acquired{false};
+    std::thread waiter([&] {
+        BufferPool::Lease lease = pool.acquire();
+        acquired.store(true);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(acquired.load());
+
+    held.release();
+    waiter.join();
+    EXPECT_TRUE(acquired.load());
+    EXPECT_EQ(pool.available(), 1u);
+}
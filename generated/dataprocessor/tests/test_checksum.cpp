@@ -0,0 +1,89 @@
+/**
+ * @file test_checksum.cpp
+ * @brief Unit tests for the block checksums using Google Test framework
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include <gtest/gtest.h>
+#include "checksum.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace dataproc;
+
+namespace {
+    const uint8_t* bytes(const std::string& text)
+    {
+        return reinterpret_cast<const uint8_t*>(text.data());
+    }
+
+    std::vector<uint8_t> pseudo_random_bytes(size_t size)
+    {
+        std::vector<uint8_t> data(size);
+        uint32_t state = 2463534242u;
+        for (auto& byte : data) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            byte = static_cast<uint8_t>(state);
+        }
+        return data;
+    }
+}
+
+/* ========================================================================== */
+/* CRC32C Tests                                                              */
+/* ========================================================================== */
+
+TEST(ChecksumTest, Crc32cKnownValues) {
+    EXPECT_EQ(checksum::crc32c(0, nullptr, 0), 0u);
+    EXPECT_EQ(checksum::crc32c(0, bytes("123456789"), 9), 0xE3069283u);
+    EXPECT_EQ(checksum::crc32c_portable(0, bytes("123456789"), 9), 0xE3069283u);
+
+    const std::vector<uint8_t> zeros(32, 0);
+    EXPECT_EQ(checksum::crc32c(0, zeros.data(), zeros.size()), 0x8A9136AAu);
+}
+
+TEST(ChecksumTest, Crc32cMatchesPortableAcrossSizesAndAlignments) {
+    // Covers the tail loop and both interleaved lane sizes of the hardware path
+    const std::vector<uint8_t> data = pseudo_random_bytes(3 * 8192 * 2 + 3 * 256 + 64);
+    for (size_t size : {size_t{0}, size_t{1}, size_t{7}, size_t{8}, size_t{255}, size_t{768},
+                        size_t{769}, size_t{3 * 8192}, size_t{3 * 8192 + 3 * 256 + 9}, data.size() - 7}) {
+        for (size_t offset = 0; offset < 4; ++offset) {
+            EXPECT_EQ(checksum::crc32c(0, data.data() + offset, size),
+                      checksum::crc32c_portable(0, data.data() + offset, size))
+                << "size " << size << " offset " << offset;
+        }
+    }
+}
+
+TEST(ChecksumTest, Crc32cCanBeExtended) {
+    const std::vector<uint8_t> data = pseudo_random_bytes(50000);
+    const uint32_t whole = checksum::crc32c(0, data.data(), data.size());
+    const uint32_t first = checksum::crc32c(0, data.data(), 12345);
+    EXPECT_EQ(checksum::crc32c(first, data.data() + 12345, data.size() - 12345), whole);
+}
+
+/* ========================================================================== */
+/* xxHash64 Tests                                                            */
+/* ========================================================================== */
+
+TEST(ChecksumTest, XxHash64KnownValues) {
+    EXPECT_EQ(checksum::xxhash64(nullptr, 0), 0xEF46DB3751D8E999ull);
+    EXPECT_EQ(checksum::xxhash64(bytes("a"), 1), 0xD24EC4F1A98C6E5Bull);
+    EXPECT_EQ(checksum::xxhash64(bytes("abc"), 3), 0x44BC2CF5AD770999ull);
+
+    const std::string long_text = "Nobody inspects the spammish repetition";
+    EXPECT_EQ(checksum::xxhash64(bytes(long_text), long_text.size()), 0xFBCEA83C8A378BF1ull);
+}
+
+TEST(ChecksumTest, XxHash64DetectsSingleBitFlip) {
+    std::vector<uint8_t> data = pseudo_random_bytes(4096);
+    const uint64_t original = checksum::xxhash64(data.data(), data.size());
+    data[1000] ^= 0x10;
+    EXPECT_NE(checksum::xxhash64(data.data(), data.size()), original);
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_chunker.cpp
+ * @brief Unit tests for the content-defined chunker using Google Test framework
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include <gtest/gtest.h>
+#include "chunker.h"
+
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace dataproc;
+
+namespace {
+    std::vector<uint8_t> pseudo_random_bytes(size_t size, uint32_t seed = 2463534242u)
+    {
+        std::vector<uint8_t> data(size);
+        uint32_t state = seed;
+        for (auto& byte : data) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            byte = static_cast<uint8_t>(state);
+        }
+        return data;
+    }
+
+    /**
+     * @brief Chunk lengths for @p data taken as a whole input
+     */
+    std::vector<size_t> chunk_lengths(const ContentChunker& chunker, const std::vector<uint8_t>& data)
+    {
+        std::vector<size_t> lengths;
+        for (size_t offset = 0; offset < data.size();) {
+            const size_t length = chunker.next_chunk(std::span<const uint8_t>(data).subspan(offset));
+            lengths.push_back(length);
+            offset += length;
+        }
+        return lengths;
+    }
+
+    /**
+     * @brief Chunk contents, for comparing which chunks two inputs share
+     */
+    std::set<std::vector<uint8_t>> chunk_set(const ContentChunker& chunker, const std::vector<uint8_t>& data)
+    {
+        std::set<std::vector<uint8_t>> chunks;
+        size_t offset = 0;
+        for (const size_t length : chunk_lengths(chunker, data)) {
+            if (length > data.size() - offset) {
+                ADD_FAILURE() << "chunk at offset " << offset << " runs past the input";
+                break;
+            }
+            const auto chunk = std::span<const uint8_t>(data).subspan(offset, length);
+            chunks.emplace(chunk.begin(), chunk.end());
+            offset += length;
+        }
+        return chunks;
+    }
+}
+
+/* ========================================================================== */
+/* Chunk Boundary Tests                                                      */
+/* ========================================================================== */
+
+TEST(ContentChunkerTest, ChunksStayWithinBoundsAndAverageNearTarget) {
+    const ContentChunker chunker(8192);
+    EXPECT_EQ(chunker.min_size(), 1024u);
+    EXPECT_EQ(chunker.average_size(), 4096u);
+    EXPECT_EQ(chunker.max_size(), 8192u);
+
+    const std::vector<uint8_t> data = pseudo_random_bytes(8 * 1024 * 1024);
+    const std::vector<size_t> lengths = chunk_lengths(chunker, data);
+    for (size_t i = 0; i + 1 < lengths.size(); ++i) {
+        ASSERT_GT(lengths[i], chunker.min_size());
+        ASSERT_LE(lengths[i], chunker.max_size());
+    }
+    const size_t average = data.size() / lengths.size();
+    EXPECT_GT(average, chunker.average_size() * 3 / 4);
+    EXPECT_LT(average, chunker.average_size() * 3 / 2);
+
+    /* Constant data never matches the hash, so it is cut at max_size */
+    const std::vector<uint8_t> zeros(5 * 8192 + 100, 0);
+    EXPECT_EQ(chunk_lengths(chunker, zeros), (std::vector<size_t>{8192, 8192, 8192, 8192, 8192, 100}));
+}
+
+TEST(ContentChunkerTest, FindCutNeedsOnlyTheChunkItself) {
+    const ContentChunker chunker(4096);
+    const std::vector<uint8_t> data = pseudo_random_bytes(64 * 1024);
+    const std::span<const uint8_t> all(data);
+
+    size_t offset = 0;
+    for (const size_t length : chunk_lengths(chunker, data)) {
+        if (offset + length == data.size()) {
+            break;
+        }
+        /* Any prefix holding the chunk gives the same cut, a shorter one none */
+        EXPECT_EQ(chunker.find_cut(all.subspan(offset, length)), length);
+        EXPECT_EQ(chunker.find_cut(all.subspan(offset, std::min(data.size() - offset, length + 777))), length);
+        EXPECT_EQ(chunker.find_cut(all.subspan(offset, length - 1)), 0u);
+        offset += length;
+    }
+    EXPECT_EQ(chunker.find_cut(all.first(chunker.min_size())), 0u);
+    EXPECT_EQ(chunker.next_chunk(all.first(100)), 100u);
+    EXPECT_EQ(chunker.next_chunk(all.first(0)), 0u);
+}
+
+TEST(ContentChunkerTest, BoundariesResynchronizeAfterAnEdit) {
+    const ContentChunker chunker(8192);
+    const std::vector<uint8_t> original = pseudo_random_bytes(2 * 1024 * 1024);
+
+    /* Insert a few bytes near the start; fixed chunks would all shift */
+    std::vector<uint8_t> edited = original;
+    const std::vector<uint8_t> inserted = pseudo_random_bytes(13, 7);
+    edited.insert(edited.begin() + 10000, inserted.begin(), inserted.end());
+
+    const auto before = chunk_set(chunker, original);
+    const auto after = chunk_set(chunker, edited);
+    size_t shared = 0;
+    for (const auto& chunk : after) {
+        shared += before.count(chunk);
+    }
+    EXPECT_GE(shared + 3, after.size());
+}
+
+/* ========================================================================== */
+/* Performance Tests                                                         */
+/* ========================================================================== */
+
+TEST(ContentChunkerTest, DISABLED_ChunkingThroughput) {
+    /* 256 MiB through the rolling hash; disabled in the unit suite */
+    const std::vector<uint8_t> data = pseudo_random_bytes(64 * 1024 * 1024);
+    const ContentChunker chunker(64 * 1024);
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t chunks = 0;
+    for (int round = 0; round < 4; ++round) {
+        chunks += chunk_lengths(chunker, data).size();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GT(chunks, 0u);
+
+    const double mbps = 4.0 * static_cast<double>(data.size()) / (1024.0 * 1024.0) / elapsed.count();
+    RecordProperty("throughput_mbps", std::to_string(mbps));
+}
@@ -0,0 +1,119 @@
+/**
+ * @file test_correlation_kernel.cpp
+ * @brief Unit tests for the blocked correlation product using Google Test framework
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include <gtest/gtest.h>
+#include "correlation_kernel.h"
+
+#include <chrono>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace dataproc;
+
+namespace {
+    constexpr size_t TILE = correlation::TILE_COLUMNS;
+
+    /**
+     * @brief Two tiles of columns in one aligned allocation, filled with small integers
+     *
+     * Integer products sum exactly, so every kernel must match the reference bit for bit.
+     */
+    struct TilePair {
+        size_t stride;
+        double* data;
+
+        explicit TilePair(size_t rows)
+            : stride(rows),
+              data(static_cast<double*>(::operator new(2 * TILE * rows * sizeof(double), std::align_val_t{64})))
+        {
+            uint32_t state = 2463534242u;
+            for (size_t i = 0; i < 2 * TILE * rows; ++i) {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                data[i] = static_cast<double>(static_cast<int>(state % 17) - 8);
+            }
+        }
+
+        ~TilePair() { ::operator delete(data, std::align_val_t{64}); }
+
+        TilePair(const TilePair&) = delete;
+        TilePair& operator=(const TilePair&) = delete;
+
+        const double* tile(size_t index) const { return data + index * TILE * stride; }
+
+        double dot(size_t tile_a, size_t i, size_t tile_b, size_t j) const
+        {
+            double sum = 0.0;
+            for (size_t k = 0; k < stride; ++k) {
+                sum += tile(tile_a)[i * stride + k] * tile(tile_b)[j * stride + k];
+            }
+            return sum;
+        }
+    };
+}
+
+/* ========================================================================== */
+/* Tile Product Tests                                                        */
+/* ========================================================================== */
+
+TEST(CorrelationKernelTest, EveryKernelMatchesDotProducts) {
+    const auto best = static_cast<int>(correlation::best_kernel());
+    /* Below, at and across the row slab size */
+    for (const size_t rows : {size_t{8}, size_t{64}, correlation::SAMPLE_BLOCK, correlation::SAMPLE_BLOCK * 2 + 24}) {
+        const TilePair tiles(rows);
+        std::vector<double> out(TILE * TILE);
+        for (int kernel = 0; kernel <= best; ++kernel) {
+            correlation::tile_product(static_cast<correlation::Kernel>(kernel), tiles.tile(0), tiles.tile(1),
+                                      tiles.stride, rows, false, out.data());
+            for (size_t i = 0; i < TILE; ++i) {
+                for (size_t j = 0; j < TILE; ++j) {
+                    ASSERT_EQ(out[i * TILE + j], tiles.dot(0, i, 1, j))
+                        << "kernel " << kernel << " rows " << rows << " at " << i << "," << j;
+                }
+            }
+
+            /* A diagonal tile fills at least its upper triangle */
+            correlation::tile_product(static_cast<correlation::Kernel>(kernel), tiles.tile(1), tiles.tile(1),
+                                      tiles.stride, rows, true, out.data());
+            for (size_t i = 0; i < TILE; ++i) {
+                for (size_t j = i; j < TILE; ++j) {
+                    ASSERT_EQ(out[i * TILE + j], tiles.dot(1, i, 1, j))
+                        << "kernel " << kernel << " rows " << rows << " at " << i << "," << j;
+                }
+            }
+        }
+    }
+}
+
+/* ========================================================================== */
+/* Performance Tests                                                         */
+/* ========================================================================== */
+
+TEST(CorrelationKernelTest, DISABLED_TileThroughput) {
+    /* GFLOP/s of each supported kernel; disabled in the unit suite */
+    const size_t rows = 16384;
+    const TilePair tiles(rows);
+    std::vector<double> out(TILE * TILE);
+    const auto best = static_cast<int>(correlation::best_kernel());
+    for (int kernel = 0; kernel <= best; ++kernel) {
+        const int rounds = 10;
+        const auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            correlation::tile_product(static_cast<correlation::Kernel>(kernel), tiles.tile(0), tiles.tile(1),
+                                      tiles.stride, rows, false, out.data());
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        EXPECT_EQ(out[0], tiles.dot(0, 0, 1, 0));
+
+        const double gflops = 2.0 * rounds * TILE * TILE * static_cast<double>(rows) / elapsed.count() / 1e9;
+        RecordProperty("gflops_kernel_" + std::to_string(kernel), std::to_string(gflops));
+    }
+}
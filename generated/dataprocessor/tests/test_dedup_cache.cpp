@@ -0,0 +1,87 @@
+/**
+ * @file test_dedup_cache.cpp
+ * @brief Unit tests for the block deduplication cache using Google Test framework
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include <gtest/gtest.h>
+#include "dedup_cache.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace dataproc;
+
+namespace {
+    std::vector<uint8_t> block(uint8_t seed, size_t size = 256)
+    {
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<uint8_t>(seed * 37 + i * 11);
+        }
+        return data;
+    }
+}
+
+/* ========================================================================== */
+/* Lookup Tests                                                              */
+/* ========================================================================== */
+
+TEST(DedupCacheTest, ReportsDistanceToFirstCopy) {
+    DedupCache cache(100);
+    EXPECT_EQ(cache.capacity(), 128u);
+
+    const auto a = block(1);
+    const auto b = block(2);
+    const auto a_again = block(1);
+    cache.begin();
+    EXPECT_EQ(cache.find_or_insert(a, 0), 0u);
+    EXPECT_EQ(cache.find_or_insert(b, 1), 0u);
+    EXPECT_EQ(cache.find_or_insert(a_again, 2), 2u);
+    /* Later repeats still point at the first copy, never at a reference */
+    EXPECT_EQ(cache.find_or_insert(a_again, 5), 5u);
+    EXPECT_EQ(cache.find_or_insert(b, 6), 5u);
+}
+
+TEST(DedupCacheTest, ScopesSizesAndSmallBlocks) {
+    DedupCache cache(16);
+    const auto a = block(1);
+    cache.begin();
+    EXPECT_EQ(cache.find_or_insert(a, 0), 0u);
+
+    /* A new scope forgets everything */
+    cache.begin();
+    EXPECT_EQ(cache.find_or_insert(a, 0), 0u);
+    EXPECT_EQ(cache.find_or_insert(a, 1), 1u);
+
+    /* A prefix of the same bytes is a different block */
+    EXPECT_EQ(cache.find_or_insert(std::span<const uint8_t>(a).first(200), 2), 0u);
+
+    /* Blocks too small to be worth a reference are never matched */
+    const auto tiny = block(3, MIN_DEDUP_BLOCK_SIZE - 1);
+    EXPECT_EQ(cache.find_or_insert(tiny, 3), 0u);
+    EXPECT_EQ(cache.find_or_insert(tiny, 4), 0u);
+}
+
+TEST(DedupCacheTest, StaysBoundedUnderManyBlocks) {
+    DedupCache cache(8);
+    std::vector<std::vector<uint8_t>> blocks;
+    for (int i = 0; i < 64; ++i) {
+        blocks.push_back(block(static_cast<uint8_t>(i)));
+    }
+
+    cache.begin();
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        EXPECT_EQ(cache.find_or_insert(blocks[i], i), 0u);
+    }
+    /* A slot keeps only its newest block, so at most one hit per slot */
+    size_t found = 0;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (cache.find_or_insert(blocks[i], blocks.size() + i) != 0) {
+            ++found;
+        }
+    }
+    EXPECT_LE(found, cache.capacity());
+}
@@ -0,0 +1,146 @@
+/**
+ * @file test_lz4_codec.cpp
+ * @brief Unit tests for the in-tree LZ4 block codec using Google Test framework
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include <gtest/gtest.h>
+#include "lz4_codec.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace dataproc;
+
+/* ========================================================================== */
+/* Test Fixture Class                                                        */
+/* ========================================================================== */
+
+class Lz4CodecTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        state_ = std::make_unique<lz4::CompressState>();
+    }
+
+    std::vector<uint8_t> compress(const std::vector<uint8_t>& input) {
+        std::vector<uint8_t> compressed(lz4::compress_bound(input.size()));
+        compressed.resize(lz4::compress(*state_, input.data(), input.size(), compressed.data()));
+        return compressed;
+    }
+
+    void expect_round_trip(const std::vector<uint8_t>& input) {
+        const std::vector<uint8_t> compressed = compress(input);
+        ASSERT_LE(compressed.size(), lz4::compress_bound(input.size()));
+
+        std::vector<uint8_t> decoded(input.size());
+        ASSERT_TRUE(lz4::decompress(compressed.data(), compressed.size(), decoded.data(), decoded.size()));
+        EXPECT_EQ(decoded, input);
+    }
+
+    std::unique_ptr<lz4::CompressState> state_;
+};
+
+/* ========================================================================== */
+/* Round Trip Tests                                                          */
+/* ========================================================================== */
+
+TEST_F(Lz4CodecTest, RoundTripEmptyAndTinyInputs) {
+    for (size_t size = 0; size < 40; ++size) {
+        std::vector<uint8_t> input(size);
+        for (size_t i = 0; i < size; ++i) {
+            input[i] = static_cast<uint8_t>(i % 3);
+        }
+        expect_round_trip(input);
+    }
+}
+
+TEST_F(Lz4CodecTest, RoundTripRepetitiveInput) {
+    const std::string pattern = "stream-record:{id=42,value=3.14};";
+    std::vector<uint8_t> input;
+    while (input.size() < 100000) {
+        input.insert(input.end(), pattern.begin(), pattern.end());
+    }
+
+    const std::vector<uint8_t> compressed = compress(input);
+    EXPECT_LT(compressed.size(), input.size() / 10);
+    expect_round_trip(input);
+}
+
+TEST_F(Lz4CodecTest, RoundTripIncompressibleInput) {
+    std::vector<uint8_t> input(70000);
+    uint32_t state = 12345;
+    for (auto& byte : input) {
+        state = state * 1103515245u + 12345u;
+        byte = static_cast<uint8_t>(state >> 16);
+    }
+    expect_round_trip(input);
+}
+
+TEST_F(Lz4CodecTest, RoundTripLongRunsAndFarMatches) {
+    std::vector<uint8_t> input(200000, 0x55);
+    for (size_t i = 0; i < input.size(); i += 70001) {
+        input[i] = static_cast<uint8_t>(i);
+    }
+    expect_round_trip(input);
+}
+
+TEST_F(Lz4CodecTest, DecodesReferenceBlock) {
+    /* One literal 'a', a 14-byte match at offset 1, then five final literals */
+    const std::vector<uint8_t> block = {0x1A, 'a', 0x01, 0x00, 0x50, 'b', 'c', 'd', 'e', 'f'};
+    const std::string expected = std::string(15, 'a') + "bcdef";
+
+    std::vector<uint8_t> decoded(expected.size());
+    ASSERT_TRUE(lz4::decompress(block.data(), block.size(), decoded.data(), decoded.size()));
+    EXPECT_EQ(std::string(decoded.begin(), decoded.end()), expected);
+}
+
+TEST_F(Lz4CodecTest, OutputDoesNotDependOnEarlierBlocks) {
+    const std::string pattern = "stream-record:{id=42,value=3.14};";
+    std::vector<uint8_t> block;
+    while (block.size() < 8192) {
+        block.insert(block.end(), pattern.begin(), pattern.end());
+    }
+    const std::vector<uint8_t> first = compress(block);
+
+    std::vector<uint8_t> other(8192);
+    for (size_t i = 0; i < other.size(); ++i) {
+        other[i] = static_cast<uint8_t>((i * 7) ^ (i >> 3));
+    }
+    compress(other);
+
+    EXPECT_EQ(compress(block), first);
+}
+
+/* ========================================================================== */
+/* Malformed Input Tests                                                     */
+/* ========================================================================== */
+
+TEST_F(Lz4CodecTest, RejectsWrongDecodedSize) {
+    const std::vector<uint8_t> block = {0x1A, 'a', 0x01, 0x00, 0x50, 'b', 'c', 'd', 'e', 'f'};
+    std::vector<uint8_t> decoded(64);
+    EXPECT_FALSE(lz4::decompress(block.data(), block.size(), decoded.data(), 19));
+    EXPECT_FALSE(lz4::decompress(block.data(), block.size(), decoded.data(), 21));
+}
+
+TEST_F(Lz4CodecTest, RejectsOffsetBeforeStart) {
+    const std::vector<uint8_t> block = {0x1A, 'a', 0x02, 0x00, 0x50, 'b', 'c', 'd', 'e', 'f'};
+    std::vector<uint8_t> decoded(20);
+    EXPECT_FALSE(lz4::decompress(block.data(), block.size(), decoded.data(), decoded.size()));
+}
+
+TEST_F(Lz4CodecTest, RejectsTruncatedInput) {
+    std::vector<uint8_t> input(5000);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<uint8_t>((i * i) >> 5);
+    }
+    const std::vector<uint8_t> compressed = compress(input);
+
+    std::vector<uint8_t> decoded(input.size());
+    for (size_t length = 0; length < compressed.size(); length += 7) {
+        EXPECT_FALSE(lz4::decompress(compressed.data(), length, decoded.data(), decoded.size()));
+    }
+}
@@ -0,0 +1,139 @@
+/**
+ * @file test_ring_buffer.cpp
+ * @brief Unit tests for the lock-free ring buffers using Google Test framework
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include <gtest/gtest.h>
+#include "ring_buffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace dataproc;
+
+TEST(SpscRingTest, FifoUpToCapacity) {
+    SpscRing<int> ring(3);
+    EXPECT_EQ(ring.capacity(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        int value = i;
+        EXPECT_TRUE(ring.try_push(value));
+    }
+    int extra = 99;
+    EXPECT_FALSE(ring.try_push(extra));
+    EXPECT_EQ(extra, 99);
+
+    for (int i = 0; i < 4; ++i) {
+        int value = -1;
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    int value = -1;
+    EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST(SpscRingTest, TransfersInOrderBetweenThreads) {
+    constexpr uint64_t count = 200000;
+    SpscRing<uint64_t> ring(8);
+
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < count; ++i) {
+            ring.push(i);
+        }
+    });
+    for (uint64_t i = 0; i < count; ++i) {
+        ASSERT_EQ(ring.pop(), i);
+    }
+    producer.join();
+}
+
+TEST(MpmcRingTest, FifoUpToCapacity) {
+    MpmcRing<int> ring(4);
+    EXPECT_EQ(ring.capacity(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        int value = i;
+        EXPECT_TRUE(ring.try_push(value));
+    }
+    EXPECT_EQ(ring.size(), 4u);
+    int extra = 99;
+    EXPECT_FALSE(ring.try_push(extra));
+
+    /* Wrapping around reuses cells once they are consumed */
+    for (int lap = 0; lap < 3; ++lap) {
+        int value = -1;
+        ASSERT_TRUE(ring.try_pop(value));
+        int next = 4 + lap;
+        EXPECT_TRUE(ring.try_push(next));
+    }
+    for (int i = 3; i < 7; ++i) {
+        int value = -1;
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    int value = -1;
+    EXPECT_FALSE(ring.try_pop(value));
+    EXPECT_EQ(ring.size(), 0u);
+}
+
+TEST(MpmcRingTest, EveryItemDeliveredOnceAcrossThreads) {
+    constexpr size_t producers = 4;
+    constexpr size_t consumers = 4;
+    constexpr uint64_t per_producer = 50000;
+    MpmcRing<uint64_t> ring(16);
+
+    std::vector<std::atomic<uint32_t>> seen(producers * per_producer);
+    std::atomic<uint64_t> remaining{producers * per_producer};
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (uint64_t i = 0; i < per_producer; ++i) {
+                ring.push(p * per_producer + i + 1);  // Zero stops a consumer
+            }
+        });
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            for (;;) {
+                const uint64_t item = ring.pop();
+                if (item == 0) {
+                    return;
+                }
+                seen[item - 1].fetch_add(1);
+                if (remaining.fetch_sub(1) == 1) {
+                    for (size_t i = 0; i < consumers; ++i) {
+                        ring.push(0);
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& count : seen) {
+        ASSERT_EQ(count.load(), 1u);
+    }
+}
+
+TEST(MpmcRingTest, PopWaitsForPush) {
+    MpmcRing<int> ring(2);
+    std::atomic<bool> done{false};
+    std::thread consumer([&] {
+        EXPECT_EQ(ring.pop(), 7);
+        done.store(true);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(done.load());
+    ring.push(7);
+    consumer.join();
+    EXPECT_TRUE(done.load());
+}
@@ -0,0 +1,196 @@
+/**
+ * @file test_stream_executor.cpp
+ * @brief Unit tests for the coroutine executor and async StreamProcessor API using Google Test framework
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include <gtest/gtest.h>
+#include "stream.h"
+#include "stream_executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace dataproc;
+
+namespace {
+    StreamTask count_hops(StreamExecutor& executor, std::atomic<size_t>& hops) {
+        for (int i = 0; i < 10; ++i) {
+            co_await executor.schedule();
+            hops.fetch_add(1);
+        }
+    }
+
+    StreamTask fail_after_hop(StreamExecutor& executor) {
+        co_await executor.schedule();
+        throw std::runtime_error("task failed");
+    }
+
+    StreamTask catch_child_failure(StreamExecutor& executor, std::atomic<bool>& caught) {
+        try {
+            co_await fail_after_hop(executor);
+        } catch (const std::runtime_error&) {
+            caught.store(true);
+        }
+    }
+
+    std::vector<uint8_t> make_message(size_t stream, size_t index, size_t size) {
+        std::vector<uint8_t> message(size);
+        for (size_t i = 0; i < size; ++i) {
+            message[i] = static_cast<uint8_t>(stream * 31 + index * 7 + i);
+        }
+        return message;
+    }
+}
+
+TEST(StreamExecutorTest, RunsSpawnedTasksAndReportsFailures) {
+    StreamExecutor executor(3);
+    EXPECT_EQ(executor.thread_count(), 3u);
+
+    std::atomic<size_t> hops{0};
+    for (int i = 0; i < 1000; ++i) {
+        executor.spawn(count_hops(executor, hops));
+    }
+    executor.wait();
+    EXPECT_EQ(hops.load(), 10000u);
+
+    /* An awaiting task sees its child's exception; a spawned one reports it from wait() */
+    std::atomic<bool> caught{false};
+    executor.spawn(catch_child_failure(executor, caught));
+    executor.wait();
+    EXPECT_TRUE(caught.load());
+
+    executor.spawn(fail_after_hop(executor));
+    EXPECT_THROW(executor.wait(), std::runtime_error);
+    EXPECT_NO_THROW(executor.wait());
+}
+
+TEST(StreamExecutorTest, ThousandsOfStreamsOnTwoThreads) {
+    /* Each logical stream is a coroutine that pushes faster than the single
+     * consumer drains, so they spend most of their time suspended on flow
+     * control instead of each holding a thread */
+    constexpr size_t streams = 2000;
+    constexpr size_t messages = 40;
+    constexpr size_t message_size = 1000;
+    constexpr size_t high_watermark = 8 * 1024;
+
+    StreamConfig config;
+    config.buffer_size = 4096;
+    std::vector<std::unique_ptr<StreamProcessor>> processors;
+    std::vector<std::vector<uint8_t>> outputs(streams);
+    std::atomic<size_t> pauses{0};
+    std::atomic<size_t> overshoot{0};
+    for (size_t s = 0; s < streams; ++s) {
+        processors.push_back(std::make_unique<StreamProcessor>(config));
+        processors.back()->set_flow_control({.high_watermark = high_watermark, .on_change = [&](FlowState state) {
+            if (state == FlowState::Paused) {
+                pauses.fetch_add(1);
+            }
+        }});
+    }
+
+    StreamExecutor executor(2);
+    std::atomic<size_t> finished{0};
+    auto produce = [&](size_t s) -> StreamTask {
+        StreamProcessor& processor = *processors[s];
+        for (size_t m = 0; m < messages; ++m) {
+            const std::vector<uint8_t> message = make_message(s, m, message_size);
+            co_await processor.async_push(message, executor);
+            /* The awaiter only continues once there is room again */
+            if (processor.buffered_bytes() >= high_watermark) {
+                overshoot.fetch_add(1);
+            }
+        }
+        co_await processor.async_flush(executor);
+        EXPECT_EQ(processor.queue_depth(), 0u);
+        processor.finish();
+        finished.fetch_add(1);
+    };
+    for (size_t s = 0; s < streams; ++s) {
+        executor.spawn(produce(s));
+    }
+
+    std::thread consumer([&] {
+        while (finished.load() < streams) {
+            for (size_t s = 0; s < streams; ++s) {
+                processors[s]->drain(outputs[s]);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        for (size_t s = 0; s < streams; ++s) {
+            processors[s]->drain(outputs[s]);
+        }
+    });
+    executor.wait();
+    consumer.join();
+
+    EXPECT_GT(pauses.load(), streams);
+    EXPECT_EQ(overshoot.load(), 0u);
+    for (size_t s = 0; s < streams; ++s) {
+        std::vector<uint8_t> expected;
+        for (size_t m = 0; m < messages; ++m) {
+            const std::vector<uint8_t> message = make_message(s, m, message_size);
+            expected.insert(expected.end(), message.begin(), message.end());
+        }
+        ASSERT_EQ(outputs[s], expected) << "stream " << s;
+    }
+}
+
+TEST(StreamExecutorTest, AsyncErrorsAndDestroyedProcessor) {
+    StreamExecutor executor(1);
+    StreamConfig config;
+    config.buffer_size = 1024;
+    const std::vector<uint8_t> message(4096, 1);
+
+    /* Errors from the operation itself come out of the co_await */
+    auto processor = std::make_unique<StreamProcessor>(config);
+    processor->finish();
+    std::atomic<bool> rejected{false};
+    auto push_after_finish = [&]() -> StreamTask {
+        try {
+            co_await processor->async_push(message, executor);
+        } catch (const StreamRuntimeException&) {
+            rejected.store(true);
+        }
+    };
+    executor.spawn(push_after_finish());
+    executor.wait();
+    EXPECT_TRUE(rejected.load());
+
+    /* A coroutine parked on a processor that goes away is resumed with an error */
+    processor = std::make_unique<StreamProcessor>(config);
+    StreamFlowControl flow;
+    flow.high_watermark = 2048;
+    processor->set_flow_control(flow);
+    std::atomic<bool> failed{false};
+    std::atomic<bool> next_ran{false};
+    auto push_until_paused = [&]() -> StreamTask {
+        try {
+            co_await processor->async_push(message, executor);
+        } catch (const StreamRuntimeException&) {
+            failed.store(true);
+        }
+    };
+    auto mark = [&]() -> StreamTask {
+        next_ran.store(true);
+        co_return;
+    };
+    executor.spawn(push_until_paused());
+    executor.spawn(mark());
+    /* With one thread, the second task only runs once the first has parked */
+    while (!next_ran.load()) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(processor->flow_state(), FlowState::Paused);
+    EXPECT_FALSE(failed.load());
+    processor.reset();
+    executor.wait();
+    EXPECT_TRUE(failed.load());
+}
@@ -0,0 +1,133 @@
+/**
+ * @file test_worker_pool.cpp
+ * @brief Unit tests for the work-stealing worker pool using Google Test framework
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include <gtest/gtest.h>
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace dataproc;
+
+TEST(WorkStealingDequeTest, OwnerAndThievesTakeEveryTaskOnce) {
+    constexpr size_t count = 100000;
+    WorkStealingDeque deque;
+    deque.assign(0, count);
+
+    std::vector<std::atomic<uint32_t>> taken(count);
+    std::atomic<bool> go{false};
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; ++i) {
+        thieves.emplace_back([&] {
+            while (!go.load()) {
+            }
+            size_t task;
+            for (;;) {
+                const auto result = deque.steal(task);
+                if (result == WorkStealingDeque::Steal::Empty) {
+                    return;
+                }
+                if (result == WorkStealingDeque::Steal::Taken) {
+                    taken[task].fetch_add(1);
+                }
+            }
+        });
+    }
+
+    go.store(true);
+    size_t task;
+    size_t previous = 0;
+    bool first = true;
+    while (deque.pop(task)) {
+        /* The owner works through its share in increasing order */
+        EXPECT_TRUE(first || task > previous);
+        first = false;
+        previous = task;
+        taken[task].fetch_add(1);
+    }
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    for (const auto& count_taken : taken) {
+        ASSERT_EQ(count_taken.load(), 1u);
+    }
+}
+
+TEST(WorkerPoolTest, RunsEveryIndexOnceOnValidWorkers) {
+    WorkerPool pool(3);
+    ASSERT_EQ(pool.concurrency(), 4u);
+
+    for (size_t count : {1u, 3u, 4u, 1000u}) {
+        std::vector<std::atomic<uint32_t>> runs(count);
+        std::atomic<bool> bad_worker{false};
+        pool.parallel_for(count, [&](size_t index, size_t worker) {
+            runs[index].fetch_add(1);
+            if (worker >= pool.concurrency()) {
+                bad_worker.store(true);
+            }
+        });
+        for (const auto& run : runs) {
+            ASSERT_EQ(run.load(), 1u);
+        }
+        EXPECT_FALSE(bad_worker.load());
+    }
+}
+
+TEST(WorkerPoolTest, RethrowsTaskExceptionAndRecovers) {
+    WorkerPool pool(2);
+    EXPECT_THROW(pool.parallel_for(100, [](size_t index, size_t) {
+        if (index == 42) {
+            throw std::runtime_error("task failed");
+        }
+    }), std::runtime_error);
+
+    std::atomic<size_t> runs{0};
+    pool.parallel_for(100, [&](size_t, size_t) { runs.fetch_add(1); });
+    EXPECT_EQ(runs.load(), 100u);
+}
+
+TEST(WorkerPoolPerformanceTest, StealingShortensSkewedJobs) {
+    /* Task costs are simulated with sleeps so the comparison does not depend
+     * on how many cores the machine has. All the expensive tasks fall in the
+     * first worker's share, as when one region of the input compresses badly. */
+    constexpr size_t workers = 4;
+    constexpr size_t count = 64;
+    constexpr size_t heavy = count / workers;
+    const auto cost = [](size_t index) {
+        return std::chrono::milliseconds(index < heavy ? 10 : 1);
+    };
+
+    WorkerPool pool(workers - 1);
+    const auto time_job = [&](const WorkerPool::Task& task, size_t tasks) {
+        const auto start = std::chrono::steady_clock::now();
+        pool.parallel_for(tasks, task);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    double stealing_worst = 0;
+    double static_worst = 0;
+    for (int run = 0; run < 3; ++run) {
+        stealing_worst = std::max(stealing_worst, time_job([&](size_t index, size_t) {
+            std::this_thread::sleep_for(cost(index));
+        }, count));
+
+        /* Same work as one fixed range per worker, which nothing can rebalance */
+        static_worst = std::max(static_worst, time_job([&](size_t share, size_t) {
+            for (size_t index = share * count / workers; index < (share + 1) * count / workers; ++index) {
+                std::this_thread::sleep_for(cost(index));
+            }
+        }, workers));
+    }
+
+    EXPECT_LT(stealing_worst, static_worst * 0.75);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file test_zscore_kernel.cpp
+ * @brief Unit tests for the vectorized anomaly detection passes using Google Test framework
+ * @author Code Generator Team
+ * @version 2.1.0
+ * @date 2025-06-19
+ */
+
+#include <gtest/gtest.h>
+#include "zscore_kernel.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace dataproc;
+
+namespace {
+    /**
+     * @brief Values in [-1, 1) with every 37th point far out and a few non-finite ones
+     */
+    std::vector<double> spiky_values(size_t size)
+    {
+        std::vector<double> values(size);
+        uint32_t state = 2463534242u;
+        for (size_t i = 0; i < size; ++i) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            values[i] = static_cast<double>(state) / 2147483648.0 - 1.0;
+            if (i % 37 == 5) {
+                values[i] *= 100.0;
+            }
+        }
+        if (size > 40) {
+            values[3] = std::numeric_limits<double>::quiet_NaN();
+            values[11] = std::numeric_limits<double>::infinity();
+            values[42] = -std::numeric_limits<double>::infinity();
+        }
+        return values;
+    }
+
+    std::vector<size_t> select(zscore::Kernel kernel, const std::vector<double>& values, size_t offset,
+                               size_t size, double center, double cutoff)
+    {
+        std::vector<size_t> out(size + 1);
+        out.resize(zscore::select_outliers(kernel, values.data() + offset, size, center, cutoff, offset, out.data()));
+        return out;
+    }
+}
+
+/* ========================================================================== */
+/* Outlier Scan Tests                                                        */
+/* ========================================================================== */
+
+TEST(ZscoreKernelTest, PortableSelectsFiniteFarPoints) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    const std::vector<double> values = {1.0, 5.0, -3.0, nan, 2.0, inf, 4.0, -inf, 1.5};
+    EXPECT_EQ(select(zscore::Kernel::Portable, values, 0, values.size(), 1.0, 2.0),
+              (std::vector<size_t>{1, 2, 6}));
+    /* The cutoff is exclusive */
+    EXPECT_EQ(select(zscore::Kernel::Portable, values, 0, values.size(), 1.0, 3.0),
+              (std::vector<size_t>{1, 2}));
+    EXPECT_EQ(select(zscore::Kernel::Portable, values, 0, 0, 1.0, 3.0), std::vector<size_t>{});
+}
+
+TEST(ZscoreKernelTest, EveryKernelMatchesPortable) {
+    const std::vector<double> values = spiky_values(5000);
+    const auto best = static_cast<int>(zscore::best_kernel());
+    for (int kernel = 0; kernel <= best; ++kernel) {
+        for (const size_t size : {size_t{0}, size_t{1}, size_t{3}, size_t{4}, size_t{7}, size_t{8},
+                                  size_t{9}, size_t{63}, size_t{4096}, size_t{4990}}) {
+            for (size_t offset = 0; offset < 3; ++offset) {
+                const auto expected = select(zscore::Kernel::Portable, values, offset, size, 0.0, 2.0);
+                EXPECT_EQ(select(static_cast<zscore::Kernel>(kernel), values, offset, size, 0.0, 2.0), expected)
+                    << "kernel " << kernel << " size " << size << " offset " << offset;
+            }
+        }
+        /* Every point selected exercises the full compress path */
+        EXPECT_EQ(select(static_cast<zscore::Kernel>(kernel), values, 50, 300, 1000.0, 0.0).size(), 300u);
+    }
+}
+
+TEST(ZscoreKernelTest, AbsoluteDeviations) {
+    std::vector<double> values = {1.0, -2.0, 3.5, 0.0, 10.0};
+    zscore::absolute_deviations(values.data(), values.size(), 1.0);
+    EXPECT_EQ(values, (std::vector<double>{0.0, 3.0, 2.5, 1.0, 9.0}));
+}
+
+/* ========================================================================== */
+/* Performance Tests                                                         */
+/* ========================================================================== */
+
+TEST(ZscoreKernelTest, DISABLED_ScanThroughput) {
+    /* Times every kernel the CPU supports; disabled in the unit suite */
+    const std::vector<double> values = spiky_values(8 * 1024 * 1024);
+    std::vector<size_t> out(values.size());
+    const auto best = static_cast<int>(zscore::best_kernel());
+    for (int kernel = 0; kernel <= best; ++kernel) {
+        const auto start = std::chrono::steady_clock::now();
+        size_t selected = 0;
+        for (int round = 0; round < 4; ++round) {
+            selected += zscore::select_outliers(static_cast<zscore::Kernel>(kernel), values.data(), values.size(),
+                                                0.0, 3.0, 0, out.data());
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        EXPECT_GT(selected, 0u);
+
+        const double points_per_second = 4.0 * static_cast<double>(values.size()) / elapsed.count();
+        RecordProperty("points_per_second_kernel_" + std::to_string(kernel), std::to_string(points_per_second));
+    }
+}